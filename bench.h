@@ -0,0 +1,113 @@
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <x86intrin.h>
+
+/* Cycle-count harness shared by the bench translation units. Each BENCH
+ * runs a warmup, then BENCH_SAMPLES timed windows of `inner` back-to-back
+ * calls, and keeps the median and p99 of the per-call cost with the empty
+ * window overhead taken off. Counts are TSC ticks: pin the core clock
+ * (no turbo) when comparing runs. */
+
+#define BENCH_SAMPLES 1001
+#define BENCH_WARMUP 50
+#define BENCH_MAX_RESULTS 96
+
+typedef struct {
+    const char *name;
+    double median;
+    double p99;
+} bench_result_t;
+
+typedef struct {
+    bench_result_t r[BENCH_MAX_RESULTS];
+    int n;
+    uint64_t overhead;
+} bench_t;
+
+// lfence before rdtsc keeps earlier work out of the window; rdtscp waits for
+// the timed code to finish and the lfence after it keeps later work out
+static inline uint64_t bench_start(void) {
+    uint64_t t;
+
+    _mm_lfence();
+    t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+
+static inline uint64_t bench_stop(void) {
+    unsigned int aux;
+    uint64_t t = __rdtscp(&aux);
+
+    _mm_lfence();
+    return t;
+}
+
+static int bench_cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static inline void bench_add(bench_t *B, const char *name, uint64_t *s, int ops) {
+    bench_result_t *r;
+    uint64_t med, p99;
+
+    qsort(s, BENCH_SAMPLES, sizeof(uint64_t), bench_cmp_u64);
+    med = s[BENCH_SAMPLES / 2];
+    p99 = s[(BENCH_SAMPLES * 99) / 100];
+    med = med > B->overhead ? med - B->overhead : 0;
+    p99 = p99 > B->overhead ? p99 - B->overhead : 0;
+
+    if (B->n == BENCH_MAX_RESULTS)
+        return;
+    r = &B->r[B->n++];
+    r->name = name;
+    r->median = (double)med / ops;
+    r->p99 = (double)p99 / ops;
+}
+
+// Time BODY, run INNER times per sample and doing OPS operations per run,
+// as result NAME of B
+#define BENCH_OPS(B, NAME, INNER, OPS, BODY) \
+    do { \
+        uint64_t s_[BENCH_SAMPLES]; \
+        for (int w_ = 0; w_ < BENCH_WARMUP; w_++) \
+            for (int i_ = 0; i_ < (INNER); i_++) { BODY; } \
+        for (int k_ = 0; k_ < BENCH_SAMPLES; k_++) { \
+            uint64_t t_ = bench_start(); \
+            for (int i_ = 0; i_ < (INNER); i_++) { BODY; } \
+            s_[k_] = bench_stop() - t_; \
+        } \
+        bench_add((B), (NAME), s_, (INNER) * (OPS)); \
+    } while (0)
+
+#define BENCH(B, NAME, INNER, BODY) BENCH_OPS(B, NAME, INNER, 1, BODY)
+
+static inline void bench_init(bench_t *B) {
+    uint64_t s[BENCH_SAMPLES];
+
+    B->n = 0;
+    B->overhead = 0;
+    for (int k = 0; k < BENCH_SAMPLES; k++) {
+        uint64_t t = bench_start();
+        s[k] = bench_stop() - t;
+    }
+    qsort(s, BENCH_SAMPLES, sizeof(uint64_t), bench_cmp_u64);
+    B->overhead = s[BENCH_SAMPLES / 2];
+}
+
+static inline void bench_print(FILE *f, const bench_t *B) {
+    for (int i = 0; i < B->n; i++)
+        fprintf(f, "  > %-32s: %10.1f cycles/op  (p99 %10.1f)\n", B->r[i].name, B->r[i].median, B->r[i].p99);
+}
+
+static inline void bench_json(FILE *f, const bench_t *B, const char *backend) {
+    fprintf(f, "{\n  \"backend\": \"%s\",\n  \"samples\": %d,\n  \"overhead\": %llu,\n  \"results\": [\n",
+            backend, BENCH_SAMPLES, (unsigned long long)B->overhead);
+    for (int i = 0; i < B->n; i++)
+        fprintf(f, "    { \"name\": \"%s\", \"median\": %.1f, \"p99\": %.1f }%s\n",
+                B->r[i].name, B->r[i].median, B->r[i].p99, i + 1 < B->n ? "," : "");
+    fprintf(f, "  ]\n}\n");
+}
@@ -0,0 +1,767 @@
+/* * ORISIGN V9.7 - FIELD ARITHMETIC BENCHMARK
+ * Cycle counts (median and p99, see bench.h) for the multi-limb F_p, F_p^2,
+ * theta and quaternion kernels and the single-limb layer (bench_old.c).
+ * Run with --json for machine-readable output; the checks then go to stderr.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "constants.h"
+#include "types.h"
+#include "int.h"
+#include "fp.h"
+#include "theta.h"
+#include "quaternion.h"
+#include "field_lvl1.h"
+#include "field_lvl3.h"
+#include "field_lvl5.h"
+#include "bench_portable.h"
+#include "bench_old.h"
+
+// Four-multiplication reference for the fp2_mul check and bench
+static void fp2_mul_schoolbook(fp2_t *RES, fp2_t *a, fp2_t *b) {
+    oriint_t ac, bd, ad, bc;
+
+    fp_mul(&ac, &a->re, &b->re);
+    fp_mul(&bd, &a->im, &b->im);
+    fp_mul(&ad, &a->re, &b->im);
+    fp_mul(&bc, &a->im, &b->re);
+    fp_sub(&RES->re, &ac, &bd);
+    fp_add(&RES->im, &ad, &bc);
+    fp2_reduce(RES);
+}
+
+// Self-check of a gen_field.py level on 32 random x, y < 2^(BITS - 1) < P:
+// the constants (MM64 P = -1 mod 2^64, to_mont(1) == R1 and back),
+// from_mont(to_mont(x)) == x, inv(x) x == R (0 stays 0), sqr against
+// mul, mul against redc(mul_wide), and add/sub/neg round trips, at P - 1
+// as well. One function per level, all limb counts share the body.
+#define FIELD_LEVEL_CHECK(lv, LV)                                                   \
+    static bool lv##_fp_check(uint64_t rng) {                                       \
+        lv##_fp_t zero = { { 0 } }, one = { { 1 } }, pm1 = LV##_P;                  \
+        lv##_fp_t x, y, u, v;                                                       \
+        uint64_t w[2 * LV##_NBLOCK];                                                \
+        bool ok = true;                                                             \
+                                                                                    \
+        pm1.bitsu64[0]--;                                                           \
+        ok &= LV##_MM64 * LV##_P.bitsu64[0] == ~0ULL;                               \
+        lv##_fp_to_mont(&u, &one);                                                  \
+        ok &= memcmp(&u, &LV##_R1, sizeof(u)) == 0;                                 \
+        lv##_fp_from_mont(&u, &LV##_R1);                                            \
+        ok &= memcmp(&u, &one, sizeof(u)) == 0;                                     \
+        lv##_fp_add(&u, &pm1, &one);                                                \
+        ok &= memcmp(&u, &zero, sizeof(u)) == 0;                                    \
+        lv##_fp_sub(&u, &zero, &one);                                               \
+        ok &= memcmp(&u, &pm1, sizeof(u)) == 0;                                     \
+        lv##_fp_neg(&u, &one);                                                      \
+        ok &= memcmp(&u, &pm1, sizeof(u)) == 0;                                     \
+        lv##_fp_inv(&u, &zero);                                                     \
+        ok &= memcmp(&u, &zero, sizeof(u)) == 0;                                    \
+        for (int i = 0; i < 32; i++) {                                              \
+            for (int j = 0; j < LV##_NBLOCK; j++) {                                 \
+                rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;                \
+                x.bitsu64[j] = rng;                                                 \
+                y.bitsu64[j] = rng * 0xbf58476d1ce4e5b9ULL;                         \
+            }                                                                       \
+            x.bitsu64[LV##_NBLOCK - 1] &= (1ULL << ((LV##_BITS - 1) % 64)) - 1;     \
+            y.bitsu64[LV##_NBLOCK - 1] &= (1ULL << ((LV##_BITS - 1) % 64)) - 1;     \
+            if (i == 0)                                                             \
+                x = pm1;                                                            \
+            lv##_fp_to_mont(&u, &x);                                                \
+            lv##_fp_from_mont(&v, &u);                                              \
+            ok &= memcmp(&v, &x, sizeof(v)) == 0;                                   \
+            lv##_fp_inv(&v, &u);                                                    \
+            lv##_fp_mul(&v, &v, &u);                                                \
+            ok &= memcmp(&v, &LV##_R1, sizeof(v)) == 0;                             \
+            lv##_fp_mul(&u, &x, &x);                                                \
+            lv##_fp_sqr(&v, &x);                                                    \
+            ok &= memcmp(&u, &v, sizeof(u)) == 0;                                   \
+            lv##_fp_mul(&u, &x, &y);                                                \
+            lv##_fp_mul_wide(w, &x, &y);                                            \
+            lv##_fp_redc(&v, w);                                                    \
+            ok &= memcmp(&u, &v, sizeof(u)) == 0;                                   \
+            lv##_fp_sqr_wide(w, &x);                                                \
+            lv##_fp_redc(&v, w);                                                    \
+            lv##_fp_mul(&u, &x, &x);                                                \
+            ok &= memcmp(&u, &v, sizeof(u)) == 0;                                   \
+            lv##_fp_add(&u, &x, &y);                                                \
+            lv##_fp_sub(&u, &u, &y);                                                \
+            ok &= memcmp(&u, &x, sizeof(u)) == 0;                                   \
+            lv##_fp_add(&u, &x, &pm1);                                              \
+            lv##_fp_sub(&u, &u, &pm1);                                              \
+            ok &= memcmp(&u, &x, sizeof(u)) == 0;                                   \
+            lv##_fp_neg(&u, &x);                                                    \
+            lv##_fp_add(&u, &u, &x);                                                \
+            ok &= memcmp(&u, &zero, sizeof(u)) == 0;                                \
+        }                                                                           \
+        return ok;                                                                  \
+    }
+
+FIELD_LEVEL_CHECK(lvl1, LVL1)
+FIELD_LEVEL_CHECK(lvl3, LVL3)
+FIELD_LEVEL_CHECK(lvl5, LVL5)
+
+// Regression cases for the chain variants: CHAIN_SEEDS points of each kind
+// (random, normalized, a == 0 forced at the second step, the zero point)
+// under each of the all-zero, all-ones, alternating and random challenges.
+// The forced point solves (a + b)^2 = -xK (c + d)^2 for a, with xK the
+// kernel coordinate picked by challenge bit 0, so the canonical chain ends
+// at the zero point.
+#define CHAIN_SEEDS 3
+#define CHAIN_CASES (CHAIN_SEEDS * 4 * 4)
+
+static void chain_rand_fp2(fp2_t *x, uint64_t *rng) {
+    oriint_t *e[2] = { &x->re, &x->im };
+    for (int k = 0; k < 2; k++) {
+        oriint_clear(e[k]);
+        for (int j = 0; j < 4; j++) {
+            *rng ^= *rng << 13; *rng ^= *rng >> 7; *rng ^= *rng << 17;
+            e[k]->bitsu64[j] = *rng;
+        }
+        e[k]->bitsu64[3] >>= 6;
+        fp_reduce(e[k]);
+    }
+}
+
+static int chain_cases(thetanullpoint_t *T, oriint_t *ch) {
+    uint64_t rng = 0x2545f4914f6cdd1dULL;
+    int n = 0;
+
+    for (int m = 0; m < 4; m++) {
+        for (int s = 0; s < CHAIN_SEEDS; s++) {
+            for (int kind = 0; kind < 4; kind++, n++) {
+                thetanullpoint_t *t = &T[n];
+                fp2_t x, u, r, zero;
+                bool forced = false;
+
+                oriint_clear(&ch[n]);
+                for (int j = 0; j < 4; j++) {
+                    rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+                    ch[n].bitsu64[j] = m == 0 ? 0 : m == 1 ? ~0ULL : m == 2 ? 0x5555555555555555ULL : rng;
+                }
+                do {
+                    chain_rand_fp2(&t->a, &rng); chain_rand_fp2(&t->b, &rng);
+                    chain_rand_fp2(&t->c, &rng); chain_rand_fp2(&t->d, &rng);
+                    if (kind != 2)
+                        break;
+                    fp2_cmov(&x, &t->b, &t->c, 0 - (ch[n].bitsu64[0] & 1));
+                    fp2_add(&u, &t->c, &t->d);
+                    fp2_sqr(&u, &u);
+                    fp2_mul(&u, &u, &x);
+                    fp2_clear(&zero);
+                    fp2_sub(&u, &zero, &u);
+                    fp2_reduce(&u);
+                    forced = fp2_sqrt(&r, &u);
+                    fp2_sub(&t->a, &r, &t->b);
+                    fp2_reduce(&t->a);
+                } while (!forced);
+                if (kind == 1)
+                    canonicalize_theta(t);
+                if (kind == 3)
+                    memset(t, 0, sizeof(*t));
+            }
+        }
+    }
+    return n;
+}
+
+// chain against apply_quaternion_to_theta_chain_canonical on every case;
+// the forced cases must reach the zero point
+static bool chain_matches(void (*chain)(thetanullpoint_t *, oriint_t *)) {
+    static thetanullpoint_t T[CHAIN_CASES];
+    static oriint_t ch[CHAIN_CASES];
+    int n = chain_cases(T, ch);
+    bool ok = true;
+
+    for (int i = 0; i < n; i++) {
+        thetanullpoint_t ref = T[i], t = T[i];
+        apply_quaternion_to_theta_chain_canonical(&ref, &ch[i]);
+        chain(&t, &ch[i]);
+        ok &= memcmp(&t, &ref, sizeof(t)) == 0;
+        if (i % 4 == 2)
+            ok &= theta_is_infinity(&ref);
+    }
+    return ok;
+}
+
+// apply_quaternion_to_theta_chain_many against the canonical chain on all
+// but the last case, so the last group is padded, on the IFMA and the
+// scalar lockstep path
+static bool chain_many_matches(void) {
+    static thetanullpoint_t T[CHAIN_CASES], R[CHAIN_CASES], V[CHAIN_CASES];
+    static oriint_t ch[CHAIN_CASES];
+    int n = chain_cases(T, ch) - 1;
+    bool ok;
+
+    for (int i = 0; i < n; i++) {
+        R[i] = T[i];
+        apply_quaternion_to_theta_chain_canonical(&R[i], &ch[i]);
+    }
+    memcpy(V, T, sizeof(V));
+    apply_quaternion_to_theta_chain_many(V, ch, (size_t)n);
+    ok = memcmp(V, R, (size_t)n * sizeof(V[0])) == 0;
+#ifndef ORIINT_PORTABLE
+    if (oriint_cpu_ifma) {
+        oriint_cpu_ifma = false;
+        memcpy(V, T, sizeof(V));
+        apply_quaternion_to_theta_chain_many(V, ch, (size_t)n);
+        ok &= memcmp(V, R, (size_t)n * sizeof(V[0])) == 0;
+        oriint_cpu_ifma = true;
+    }
+#endif
+    return ok;
+}
+
+// eval_4_isogeny_theta_dual against two eval_sq_isogeny_velu_theta_dual
+// steps for every w on random dual points, on points with a == 0 in the
+// first half (X = -A) and in the second (w odd, Y = -A^2 (A + X) / B^2 - B)
+static bool eval_4_matches(void) {
+    uint64_t rng = 0x6a09e667f3bcc909ULL;
+    bool ok = true;
+
+    for (int i = 0; i < 3 * 4 * CHAIN_SEEDS; i++) {
+        int kind = i % 3;
+        uint64_t w = (uint64_t)(i / 3) & 3;
+        uint64_t zero = 0;
+        thetanullpoint_t D, S;
+        fp2_t a, b, c, xK, z;
+
+        chain_rand_fp2(&D.a, &rng); chain_rand_fp2(&D.b, &rng);
+        chain_rand_fp2(&D.c, &rng); chain_rand_fp2(&D.d, &rng);
+        fp2_clear(&z);
+        if (kind == 1) {
+            fp2_sub(&D.b, &z, &D.a);
+            fp2_reduce(&D.b);
+        }
+        if (kind == 2) {
+            w |= 1;
+            fp2_add(&a, &D.a, &D.b);
+            fp2_sqr(&c, &D.a);
+            fp2_mul(&c, &c, &a);
+            fp2_sqr(&b, &D.c);
+            fp2_inv(&b, &b);
+            fp2_mul(&c, &c, &b);
+            fp2_add(&c, &c, &D.c);
+            fp2_sub(&D.d, &z, &c);
+            fp2_reduce(&D.d);
+        }
+        S = D;
+        for (int h = 0; h < 2; h++) {
+            fp2_add(&a, &S.a, &S.b);
+            fp2_sub(&b, &S.a, &S.b);
+            fp2_add(&c, &S.c, &S.d);
+            zero |= 0 - (uint64_t)fp2_is_zero(&a);
+            fp2_cmov(&xK, &b, &c, 0 - ((w >> h) & 1));
+            eval_sq_isogeny_velu_theta_dual(&S, &a, &xK);
+        }
+        ok &= eval_4_isogeny_theta_dual(&D, w) == zero && memcmp(&D, &S, sizeof(D)) == 0;
+        if (kind != 0)
+            ok &= zero != 0;
+    }
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    oriint_t a, b, res, ref;
+    uint64_t r512[8] = { 0 };
+    bool json = argc > 1 && strcmp(argv[1], "--json") == 0;
+    FILE *out = json ? stderr : stdout;
+    bench_t B;
+
+    fprintf(out, "==============================================================\n");
+    fprintf(out, "  ORISIGN V9.7 - FIELD BENCHMARK (P = 5*2^248 - 1)\n");
+    fprintf(out, "==============================================================\n\n");
+
+    oriint_clear(&a);
+    oriint_clear(&b);
+    a.bitsu64[0] = 0x0123456789abcdefULL; a.bitsu64[1] = 0xfedcba9876543210ULL;
+    a.bitsu64[2] = 0x0f1e2d3c4b5a6978ULL; a.bitsu64[3] = 0x0312233445566778ULL;
+    b.bitsu64[0] = 0x8877665544332211ULL; b.bitsu64[1] = 0x1122334455667788ULL;
+    b.bitsu64[2] = 0x99aabbccddeeff00ULL; b.bitsu64[3] = 0x0400112233445566ULL;
+
+    // Both paths must agree before timing them
+    oriint_set(&res, &a);
+    oriint_modmul(&res, &b);
+    oriint_set(&ref, &a);
+    oriint_modmul_montgomerry(&ref, &b);
+    fprintf(out, "[CHECK] modmul == montgomery : %s\n", oriint_is_equal(&res, &ref) ? "OK" : "MISMATCH");
+
+    oriint_t am, bm;
+    fp_to_mont(&am, &a);
+    fp_to_mont(&bm, &b);
+    fp_mul(&ref, &am, &bm);
+    fp_from_mont(&ref, &ref);
+    fprintf(out, "[CHECK] fp_mul (Montgomery)  : %s\n", oriint_is_equal(&res, &ref) ? "OK" : "MISMATCH");
+
+    // Generated lvl1 field has the same P and R = 2^256 as fp.h
+    lvl1_fp_t a1, b1;
+    for (int i = 0; i < LVL1_NBLOCK; i++) {
+        a1.bitsu64[i] = am.bitsu64[i];
+        b1.bitsu64[i] = bm.bitsu64[i];
+    }
+    fp_mul(&ref, &am, &bm);
+    fp_reduce(&ref);
+    lvl1_fp_mul(&a1, &a1, &b1);
+    fprintf(out, "[CHECK] lvl1_fp_mul (generated): %s\n", memcmp(a1.bitsu64, ref.bitsu64, sizeof(a1)) == 0 && ref.bitsu64[4] == 0 ? "OK" : "MISMATCH");
+    fprintf(out, "[CHECK] lvl1/lvl3/lvl5 fields    : %s\n",
+            lvl1_fp_check(0x243f6a8885a308d3ULL) && lvl3_fp_check(0x13198a2e03707344ULL) &&
+            lvl5_fp_check(0xa4093822299f31d0ULL) ? "OK" : "MISMATCH");
+
+    // ORIINT_PORTABLE must match this backend bit for bit
+    oriint_t pa, pb;
+    bool same = true;
+    oriint_set(&res, &am); oriint_set(&pa, &am);
+    for (int i = 0; i < 1000; i++)
+        fp_mul(&res, &res, &bm);
+    portable_fp_mul_chain(&pa, &bm, 1000);
+    same &= oriint_is_equal(&res, &pa);
+    fp_sqr(&res, &res); fp_sqr(&res, &res);
+    portable_fp_sqr_chain(&pa, 2);
+    same &= oriint_is_equal(&res, &pa);
+    oriint_set(&res, &a); oriint_set(&pa, &a); oriint_set(&pb, &b);
+    for (int i = 0; i < 1000; i++)
+        oriint_modmul(&res, &b);
+    portable_modmul_chain(&pa, &pb, 1000);
+    same &= oriint_is_equal(&res, &pa);
+    oriint_modinv(&res);
+    portable_modinv_chain(&pa, 1);
+    same &= oriint_is_equal(&res, &pa);
+    fprintf(out, "[CHECK] ORIINT_PORTABLE backend: %s\n", same ? "OK" : "MISMATCH");
+
+    // Karatsuba fp2_mul against schoolbook over random inputs < 2^254 < 16P
+    fp2_t fa, fb, fk, fs;
+    uint64_t rng = 0x9e3779b97f4a7c15ULL;
+    same = true;
+    for (int i = 0; i < 10000; i++) {
+        oriint_t *e[4] = { &fa.re, &fa.im, &fb.re, &fb.im };
+        for (int k = 0; k < 4; k++) {
+            oriint_clear(e[k]);
+            for (int j = 0; j < 4; j++) {
+                rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+                e[k]->bitsu64[j] = rng;
+            }
+            e[k]->bitsu64[3] >>= (i & 1) ? 2 : 8;
+        }
+        fp2_mul_schoolbook(&fs, &fa, &fb);
+        fp2_mul(&fk, &fa, &fb);
+        same &= oriint_is_equal(&fk.re, &fs.re) & oriint_is_equal(&fk.im, &fs.im);
+    }
+    fprintf(out, "[CHECK] fp2_mul == schoolbook  : %s\n", same ? "OK" : "MISMATCH");
+
+    bench_init(&B);
+
+    // Dependent chains: each result feeds the next call
+    oriint_set(&res, &a);
+    BENCH(&B, "oriint_modmul", 100, oriint_modmul(&res, &b));
+    oriint_set(&ref, &a);
+    BENCH(&B, "oriint_montgomerymult", 100, oriint_montgomerymult(&ref, &ref, &b));
+    BENCH(&B, "oriint_modmul_montgomerry", 100, oriint_modmul_montgomerry(&ref, &b));
+    oriint_set(&res, &a);
+    BENCH(&B, "oriint_modsqr", 100, oriint_modsqr(&res));
+
+    oriint_set(&res, &am);
+    BENCH(&B, "fp_mul", 100, fp_mul(&res, &res, &bm));
+    BENCH(&B, "fp_sqr", 100, fp_sqr(&res, &res));
+
+    BENCH(&B, "oriint_mul_512 (mulq)", 100, oriint_mul_512_generic(r512, r512 + 2, b.bitsu64));
+    BENCH(&B, "oriint_mul_512 (int128)", 100, oriint_mul_512_portable(r512, r512 + 2, b.bitsu64));
+#ifndef ORIINT_PORTABLE
+    if (oriint_cpu_mulx)
+        BENCH(&B, "oriint_mul_512 (mulx/adx)", 100, oriint_mul_512_mulx(r512, r512 + 2, b.bitsu64));
+#endif
+
+    // Generated fields, one line per security level
+    lvl3_fp_t a3 = LVL3_R2;
+    lvl5_fp_t a5 = LVL5_R2;
+    BENCH(&B, "lvl1_fp_mul (4 limbs)", 100, lvl1_fp_mul(&a1, &a1, &b1));
+    BENCH(&B, "lvl3_fp_mul (6 limbs)", 100, lvl3_fp_mul(&a3, &a3, &LVL3_R2));
+    BENCH(&B, "lvl5_fp_mul (8 limbs)", 100, lvl5_fp_mul(&a5, &a5, &LVL5_R2));
+
+    // Same kernels built with ORIINT_PORTABLE (bench_portable.c)
+    oriint_set(&pa, &a);
+    BENCH_OPS(&B, "oriint_modmul (portable)", 1, 100, portable_modmul_chain(&pa, &pb, 100));
+    oriint_set(&pa, &am);
+    BENCH_OPS(&B, "fp_mul (portable)", 1, 100, portable_fp_mul_chain(&pa, &bm, 100));
+    BENCH_OPS(&B, "fp_sqr (portable)", 1, 100, portable_fp_sqr_chain(&pa, 100));
+    oriint_set(&pb, &a);
+    BENCH(&B, "oriint_modinv (portable)", 1, portable_modinv_chain(&pb, 1));
+
+    // Inversion, exponentiation, square root, Legendre symbol
+    oriint_t pm2, sq, resv;
+    volatile int sym = 0;
+    oriint_set(&pm2, &P_INV_EXP);
+    oriint_set(&sq, &a);
+    oriint_modsqr(&sq);
+    oriint_set(&res, &a);
+    oriint_set(&resv, &a);
+    // The window ladder and the addition chains against square-and-multiply:
+    // full-width exponents (with 0, all ones and the top bit alone), P - 2
+    // against the safegcd inverse and (P + 1) / 4
+    same = true;
+    for (int i = 0; i < 64; i++) {
+        oriint_t xe, e, u, v;
+        oriint_clear(&xe);
+        for (int j = 0; j < NBLOCK; j++) {
+            rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+            e.bitsu64[j] = i == 0 ? 0 : i == 1 ? ~0ULL : i == 2 ? (uint64_t)(j == NBLOCK - 1) << 63 : rng;
+            if (j < 4)
+                xe.bitsu64[j] = i == 3 ? 0 : rng * 0xbf58476d1ce4e5b9ULL;
+        }
+        xe.bitsu64[3] >>= 6;
+        oriint_fold_p(&xe);
+        oriint_modexp_ct(&u, &xe, &e);
+        oriint_modexp_vartime(&v, &xe, &e);
+        same &= oriint_is_equal(&u, &v);
+        oriint_set(&u, &xe);
+        oriint_set(&v, &xe);
+        oriint_modinv_fermat(&u);
+        oriint_modinv(&v);
+        same &= oriint_is_equal(&u, &v);
+        oriint_modpow_sqrt(&u, &xe);
+        oriint_modexp_vartime(&v, &xe, &P_SQRT_EXP);
+        same &= oriint_is_equal(&u, &v);
+    }
+    fprintf(out, "[CHECK] modexp_ct, fermat, sqrt chain: %s\n", same ? "OK" : "MISMATCH");
+    BENCH(&B, "oriint_modinv (safegcd)", 1, oriint_modinv(&res));
+    BENCH(&B, "oriint_modinv_vartime", 1, oriint_modinv_vartime(&resv));
+    oriint_set(&ref, &a);
+    BENCH(&B, "oriint_modexp_ct a^(P-2)", 1, oriint_modexp_ct(&ref, &ref, &pm2));
+    BENCH(&B, "oriint_modinv_fermat", 1, oriint_modinv_fermat(&ref));
+    BENCH(&B, "oriint_modpow_sqrt", 1, oriint_modpow_sqrt(&ref, &ref));
+    BENCH(&B, "oriint_modsqrt", 1, sym += oriint_modsqrt(&ref, &sq));
+    // Both Legendre variants against a^((P-1)/2) = 1, P - 1 or 0: 0, 1,
+    // P - 1, P itself, small powers of two, random squares x^2 and
+    // non-squares -x^2, and 2^243 and 2^247 - 1, which like P - 1 take
+    // 18 outer rounds, the most seen (random inputs take 11 to 15)
+    oriint_t pm1h, one;
+    oriint_set_one(&one);
+    oriint_set(&pm1h, &P_SQRT_EXP);
+    oriint_add_3(&pm1h, &pm1h, &pm1h);
+    oriint_sub_3(&pm1h, &pm1h, &one);
+    same = true;
+    for (int i = 0; i < 64; i++) {
+        oriint_t xl, v;
+        int want;
+        oriint_clear(&xl);
+        if (i == 1) {
+            oriint_set_one(&xl);
+        } else if (i == 2) {
+            oriint_sub_3(&xl, &P, &one);
+        } else if (i == 3) {
+            oriint_set(&xl, &P);
+        } else if (i < 12) {
+            xl.bitsu64[0] = 1ULL << (i - 3);
+        } else if (i == 12) {
+            xl.bitsu64[3] = 1ULL << (243 - 192);
+        } else if (i == 13) {
+            xl.bitsu64[3] = 1ULL << (247 - 192);
+            oriint_sub_3(&xl, &xl, &one);
+        } else if (i > 13) {
+            for (int j = 0; j < 4; j++) {
+                rng ^= rng << 13; rng ^= rng >> 7; rng ^= rng << 17;
+                xl.bitsu64[j] = rng;
+            }
+            xl.bitsu64[3] >>= 6;
+            oriint_fold_p(&xl);
+            oriint_modsqr(&xl);
+            if (i & 1)
+                oriint_sub_3(&xl, &P, &xl);
+        }
+        oriint_modexp_vartime(&v, &xl, &pm1h);
+        want = oriint_is_zero(&v) ? 0 : oriint_is_equal(&v, &one) ? 1 : -1;
+        oriint_sub_3(&v, &P, &v);
+        same &= want != -1 || oriint_is_equal(&v, &one);
+        same &= oriint_legendre(&xl) == want && oriint_legendre_vartime(&xl) == want;
+    }
+    fprintf(out, "[CHECK] legendre == a^((P-1)/2)  : %s\n", same ? "OK" : "MISMATCH");
+    BENCH(&B, "oriint_legendre", 1, sym += oriint_legendre(&ref); ref.bitsu64[0]++);
+    BENCH(&B, "oriint_legendre_vartime", 1, sym += oriint_legendre_vartime(&ref); ref.bitsu64[0]++);
+
+    // F_p^2: single inversions vs Montgomery's trick over 16
+    fp2_t xs[16], ys[16], z2;
+    for (int k = 0; k < 16; k++) {
+        fp_set_u64(&xs[k].re, 1000003ULL * (k + 1));
+        oriint_set(&xs[k].im, &am);
+    }
+    // Inverses are reduced, also for a zero imaginary part (odd k)
+    fp2_t xr[16];
+    bool inv_ok = true;
+    for (int k = 0; k < 16; k++) {
+        xr[k] = xs[k];
+        if (k & 1)
+            oriint_clear(&xr[k].im);
+    }
+    fp2_inv_batch(ys, xr, 16);
+    for (int k = 0; k < 16; k++) {
+        fp2_t v, w, one;
+        fp2_set_one(&one);
+        fp2_inv(&v, &xr[k]);
+        w = v;
+        fp2_reduce(&w);
+        inv_ok &= memcmp(&v, &w, sizeof(v)) == 0 && memcmp(&v, &ys[k], sizeof(v)) == 0;
+        fp2_inv_vartime(&w, &xr[k]);
+        inv_ok &= memcmp(&v, &w, sizeof(v)) == 0;
+        fp2_mul(&w, &xr[k], &v);
+        inv_ok &= fp2_equal(&w, &one);
+    }
+    fprintf(out, "[CHECK] fp2_inv reduced output : %s\n", inv_ok ? "OK" : "MISMATCH");
+    // fp_inv_batch and fp2_inv_batch against single inversions for every
+    // n <= 16, without zeros and with zero inputs first, in the middle and last
+    inv_ok = true;
+    for (size_t n = 1; n <= 16; n++) {
+        for (int zeros = 0; zeros < 2; zeros++) {
+            oriint_t fx[16], fy[16];
+            fp2_t gx[16], gy[16];
+            for (size_t k = 0; k < n; k++) {
+                fx[k] = xr[k].re;
+                gx[k] = xr[k];
+                if (zeros && (k == 0 || k == n / 2 || k == n - 1)) {
+                    oriint_clear(&fx[k]);
+                    fp2_clear(&gx[k]);
+                }
+            }
+            fp_inv_batch(fy, fx, n);
+            fp2_inv_batch(gy, gx, n);
+            for (size_t k = 0; k < n; k++) {
+                oriint_t v = fx[k];
+                fp2_t w;
+                fp_inv(&v);
+                fp2_inv(&w, &gx[k]);
+                inv_ok &= oriint_is_equal(&v, &fy[k]) && memcmp(&w, &gy[k], sizeof(w)) == 0;
+            }
+        }
+    }
+    fprintf(out, "[CHECK] fp_inv_batch, zeros  : %s\n", inv_ok ? "OK" : "MISMATCH");
+    z2 = xs[0];
+    BENCH(&B, "fp2_mul (karatsuba)", 100, fp2_mul(&z2, &z2, &xs[1]));
+    BENCH(&B, "fp2_mul (schoolbook)", 100, fp2_mul_schoolbook(&z2, &z2, &xs[1]));
+    BENCH(&B, "fp2_sqr", 100, fp2_sqr(&z2, &z2));
+    BENCH(&B, "fp2_inv", 1, fp2_inv(&z2, &z2));
+    BENCH(&B, "fp2_inv_vartime", 1, fp2_inv_vartime(&z2, &z2));
+    BENCH_OPS(&B, "fp2_inv_batch (n = 16, per elem)", 1, 16, fp2_inv_batch(ys, xs, 16));
+
+    // F_p^2 square root: two fp_pow_p34 chains
+    fp2_t sq2, rt, rt2;
+    volatile bool ok = true;
+    fp2_sqr(&sq2, &xs[3]);
+    fp2_reduce(&sq2);
+    ok &= fp2_sqrt(&rt, &sq2);
+    fp2_sqr(&rt2, &rt);
+    ok &= fp2_equal(&rt2, &sq2);
+    ok &= fp2_sqrt_vartime(&rt, &sq2);
+    fp2_sqr(&rt2, &rt);
+    ok &= fp2_equal(&rt2, &sq2);
+    // both paths agree on squareness over mixed inputs (about half are not,
+    // some with y = 0); nsq keeps the last non-square for the bench
+    fp2_t nsq = sq2;
+    for (int k = 0; k < 32; k++) {
+        fp2_t u = xs[k & 15];
+        bool c1, c2;
+        fp_add(&u.re, &u.re, &xs[(k + 5) & 15].im);
+        if (k & 4)
+            oriint_clear(&u.im);
+        fp2_reduce(&u);
+        c1 = fp2_sqrt(&rt, &u);
+        c2 = fp2_sqrt_vartime(&rt2, &u);
+        ok &= c1 == c2;
+        if (c2) {
+            fp2_sqr(&rt2, &rt2);
+            ok &= fp2_equal(&rt2, &u);
+        } else {
+            nsq = u;
+        }
+    }
+    ok &= !fp2_sqrt_vartime(&rt, &nsq);
+    fprintf(out, "[CHECK] fp2_sqrt (ct, vartime): %s\n", ok ? "OK" : "MISMATCH");
+    // fp2_is_square against fp2_sqrt: zero, explicit squares and the mix
+    // above
+    ok = true;
+    for (int k = 0; k < 32; k++) {
+        fp2_t u = xs[k & 15];
+        bool c;
+        fp_add(&u.re, &u.re, &xs[(k + 5) & 15].im);
+        if (k & 4)
+            oriint_clear(&u.im);
+        if (k & 8)
+            fp2_sqr(&u, &u);
+        if (k == 0)
+            fp2_clear(&u);
+        fp2_reduce(&u);
+        c = fp2_sqrt(&rt, &u);
+        ok &= fp2_is_square(&u) == c && fp2_is_square_vartime(&u) == c;
+    }
+    ok &= !fp2_is_square(&nsq) && !fp2_is_square_vartime(&nsq);
+    fprintf(out, "[CHECK] fp2_is_square == fp2_sqrt: %s\n", ok ? "OK" : "MISMATCH");
+    oriint_set(&ref, &sq2.re);
+    BENCH(&B, "fp_sqrt (fp_pow_p34)", 1, ok ^= fp_sqrt(&ref, &ref));
+    BENCH(&B, "fp2_sqrt", 1, ok ^= fp2_sqrt(&rt, &sq2));
+    BENCH(&B, "fp2_sqrt_vartime", 1, ok ^= fp2_sqrt_vartime(&rt, &sq2));
+    BENCH(&B, "fp2_sqrt_vartime (non-square)", 1, ok ^= fp2_sqrt_vartime(&rt, &nsq));
+
+    // One 2-isogeny theta step: dispatched, scalar and four-lane IFMA
+    thetanullpoint_t th;
+    fp2_t xk;
+    th.a = xs[0]; th.b = xs[1]; th.c = xs[2]; th.d = xs[3];
+    xk = xs[4];
+    fp2_reduce(&th.a); fp2_reduce(&th.b); fp2_reduce(&th.c); fp2_reduce(&th.d); fp2_reduce(&xk);
+#ifndef ORIINT_PORTABLE
+    if (oriint_cpu_ifma) {
+        thetanullpoint_t t4 = th, t1 = th;
+        eval_sq_isogeny_velu_theta_x4(&t4, &xk);
+        eval_sq_isogeny_velu_theta_scalar(&t1, &xk);
+        fprintf(out, "[CHECK] theta step x4 == scalar: %s\n", memcmp(&t4, &t1, sizeof(t4)) == 0 ? "OK" : "MISMATCH");
+    }
+#endif
+    BENCH(&B, "eval_sq_isogeny_velu_theta", 10, eval_sq_isogeny_velu_theta(&th, &xk));
+    BENCH(&B, "theta step (scalar)", 10, eval_sq_isogeny_velu_theta_scalar(&th, &xk));
+#ifndef ORIINT_PORTABLE
+    if (oriint_cpu_ifma)
+        BENCH(&B, "theta step (ifma x4)", 10, eval_sq_isogeny_velu_theta_x4(&th, &xk));
+#endif
+    BENCH(&B, "canonicalize_theta", 1, canonicalize_theta(&th));
+
+    // Projective step against the dual one: same eight products; the dual
+    // step trades eight Hadamard add/subs and four reductions for three
+    // add/subs forming a and xK
+    thetanullpoint_t td = th;
+    fp2_t da, dx;
+    BENCH(&B, "theta step (projective)", 10, eval_sq_isogeny_velu_theta_proj(&th, &xk));
+    BENCH(&B, "theta step (dual)", 10,
+          fp2_add(&da, &td.a, &td.b); fp2_sub(&dx, &td.a, &td.b);
+          fp2_add(&xk, &td.c, &td.d); fp2_cmov(&xk, &dx, &xk, 0 - (da.re.bitsu64[0] & 1));
+          eval_sq_isogeny_velu_theta_dual(&td, &da, &xk));
+
+    // Isogeny chain: one normalization at the end against one per step
+    thetanullpoint_t tc1 = th, tc2 = th, tc3 = th, tc4 = th, tc5 = th;
+    oriint_t chal;
+    oriint_set(&chal, &am);
+    apply_quaternion_to_theta_chain(&tc1, &chal);
+    apply_quaternion_to_theta_chain_canonical(&tc2, &chal);
+    apply_quaternion_to_theta_chain_proj(&tc3, &chal);
+    apply_quaternion_to_theta_chain_vartime(&tc4, &chal);
+    apply_quaternion_to_theta_chain_radix4(&tc5, &chal);
+    fprintf(out, "[CHECK] projective theta chain : %s\n", memcmp(&tc3, &tc2, sizeof(tc1)) == 0 ? "OK" : "MISMATCH");
+    fprintf(out, "[CHECK] projective chain (%d cases): %s\n", CHAIN_CASES,
+            chain_matches(apply_quaternion_to_theta_chain_proj) ? "OK" : "MISMATCH");
+    fprintf(out, "[CHECK] dual chain (%d cases)      : %s\n", CHAIN_CASES,
+            chain_matches(apply_quaternion_to_theta_chain) &&
+            chain_matches(apply_quaternion_to_theta_chain_vartime) ? "OK" : "MISMATCH");
+    fprintf(out, "[CHECK] radix-4 chain (%d cases)   : %s\n", CHAIN_CASES,
+            chain_matches(apply_quaternion_to_theta_chain_radix4) && eval_4_matches() ? "OK" : "MISMATCH");
+    fprintf(out, "[CHECK] dual theta chain       : %s\n",
+            memcmp(&tc1, &tc2, sizeof(tc1)) == 0 && memcmp(&tc4, &tc2, sizeof(tc1)) == 0 ? "OK" : "MISMATCH");
+    fprintf(out, "[CHECK] radix-4 theta chain    : %s\n", memcmp(&tc5, &tc2, sizeof(tc1)) == 0 ? "OK" : "MISMATCH");
+    BENCH(&B, "theta chain (dual)", 1, apply_quaternion_to_theta_chain(&tc1, &chal));
+    BENCH(&B, "theta chain (dual, radix-4)", 1, apply_quaternion_to_theta_chain_radix4(&tc5, &chal));
+    BENCH(&B, "theta chain (projective)", 1, apply_quaternion_to_theta_chain_proj(&tc3, &chal));
+    BENCH(&B, "theta chain (canonical)", 1, apply_quaternion_to_theta_chain_canonical(&tc2, &chal));
+
+    // Multi-buffer chain: THETA_BATCH_LANES points with their own challenges
+    // in lockstep, per-point cost against the single-point chain above
+    thetanullpoint_t tb[THETA_BATCH_LANES + 2], tbr[THETA_BATCH_LANES + 2];
+    oriint_t chb[THETA_BATCH_LANES + 2];
+    theta_batch_t tbatch;
+    bool batch_ok = true;
+    for (int i = 0; i < THETA_BATCH_LANES + 2; i++) {
+        tb[i].a = xs[i % 8]; tb[i].b = xs[(i + 1) % 8]; tb[i].c = xs[(i + 2) % 8]; tb[i].d = xs[(i + 3) % 8];
+        fp2_reduce(&tb[i].a); fp2_reduce(&tb[i].b); fp2_reduce(&tb[i].c); fp2_reduce(&tb[i].d);
+        oriint_set(&chb[i], &am);
+        chb[i].bitsu64[i & 3] ^= 0x9e3779b97f4a7c15ULL * (uint64_t)(i + 1);
+        tbr[i] = tb[i];
+        apply_quaternion_to_theta_chain(&tbr[i], &chb[i]);
+    }
+    theta_batch_load(&tbatch, tb, THETA_BATCH_LANES);
+    apply_quaternion_to_theta_chain_many(tb, chb, THETA_BATCH_LANES + 2);
+    batch_ok = memcmp(tb, tbr, sizeof(tb)) == 0;
+#ifndef ORIINT_PORTABLE
+    // the scalar lockstep path as well when IFMA would take over
+    if (oriint_cpu_ifma) {
+        thetanullpoint_t tbs[THETA_BATCH_LANES];
+        oriint_cpu_ifma = false;
+        for (int i = 0; i < THETA_BATCH_LANES; i++) {
+            tbs[i].a = tbatch.a[i]; tbs[i].b = tbatch.b[i]; tbs[i].c = tbatch.c[i]; tbs[i].d = tbatch.d[i];
+        }
+        apply_quaternion_to_theta_chain_many(tbs, chb, THETA_BATCH_LANES);
+        batch_ok &= memcmp(tbs, tbr, sizeof(tbs)) == 0;
+        BENCH_OPS(&B, "theta chain batch scalar (per pt)", 1, THETA_BATCH_LANES,
+                  apply_quaternion_to_theta_chain_batch(&tbatch, chb));
+        oriint_cpu_ifma = true;
+    }
+#endif
+    fprintf(out, "[CHECK] theta chain batch (x%d)  : %s\n", THETA_BATCH_LANES, batch_ok ? "OK" : "MISMATCH");
+    fprintf(out, "[CHECK] theta chain many (%d cases): %s\n", CHAIN_CASES - 1, chain_many_matches() ? "OK" : "MISMATCH");
+    BENCH_OPS(&B, "theta chain batch (per point)", 1, THETA_BATCH_LANES,
+              apply_quaternion_to_theta_chain_batch(&tbatch, chb));
+
+    // 4-limb storage: round trip and cost of a store/load pair
+    thetapacked_t tp;
+    thetanullpoint_t tl;
+    theta_store(&tp, &th);
+    theta_load(&tl, &tp);
+    fprintf(out, "[CHECK] theta_store/load (%zu -> %zu B): %s\n", sizeof(thetanullpoint_t), sizeof(thetapacked_t),
+            memcmp(&tl, &th, sizeof(tl)) == 0 ? "OK" : "MISMATCH");
+    BENCH(&B, "theta_store + theta_load", 100, theta_store(&tp, &tl); theta_load(&tl, &tp));
+
+    // Quaternion action: fp2_mul_sum against separately reduced products
+    quaternion_t qs;
+    thetanullpoint_t tq = th, tr = th;
+    fp2_t pw, px, py, pz, sum0, sum1;
+    oriint_set(&qs.w, &am); oriint_set(&qs.x, &bm); oriint_set(&qs.y, &xs[5].re); oriint_set(&qs.z, &xs[6].re);
+    quat_reduce(&qs);
+    apply_quaternion_action_to_theta(&tq, &qs);
+    fp2_mul_scalar(&pw, &tr.b, &qs.w); fp2_mul_scalar(&px, &tr.a, &qs.x);
+    fp2_mul_scalar(&py, &tr.d, &qs.y); fp2_mul_scalar(&pz, &tr.c, &qs.z);
+    fp2_sub(&sum0, &pw, &px); fp2_sub(&sum1, &py, &pz);
+    fp2_add(&sum0, &sum0, &sum1);
+    fp2_reduce(&sum0);
+    fp2_mul_sum(&sum1, (fp2_t *[4]){ &tr.b, &tr.a, &tr.d, &tr.c }, (oriint_t *[4]){ &qs.w, &qs.x, &qs.y, &qs.z }, 4, 0xa);
+    fprintf(out, "[CHECK] fp2_mul_sum == products: %s\n", fp2_equal(&sum0, &sum1) ? "OK" : "MISMATCH");
+    BENCH(&B, "fp2_mul_scalar + add/sub (x4)", 100,
+          fp2_mul_scalar(&pw, &tr.b, &qs.w); fp2_mul_scalar(&px, &tr.a, &qs.x);
+          fp2_mul_scalar(&py, &tr.d, &qs.y); fp2_mul_scalar(&pz, &tr.c, &qs.z);
+          fp2_sub(&sum0, &pw, &px); fp2_sub(&sum1, &py, &pz);
+          fp2_add(&tr.b, &sum0, &sum1); fp2_reduce(&tr.b));
+    BENCH(&B, "fp2_mul_sum (4 terms)", 100,
+          fp2_mul_sum(&tr.b, (fp2_t *[4]){ &tr.b, &tr.a, &tr.d, &tr.c }, (oriint_t *[4]){ &qs.w, &qs.x, &qs.y, &qs.z }, 4, 0xa));
+    BENCH(&B, "apply_quaternion_action_to_theta", 1, apply_quaternion_action_to_theta(&tq, &qs));
+
+    // Small signed coefficients (KLPT): fp2_mul_small against full products
+    const int64_t qi[4] = { 131, -77, 12, -158 };
+    tq = th; tr = th;
+    fp_set_u64(&qs.w, 131); fp_set_u64(&qs.x, 77); fp_set_u64(&qs.y, 12); fp_set_u64(&qs.z, 158);
+    oriint_clear(&ref);
+    fp_sub(&qs.x, &ref, &qs.x); fp_sub(&qs.z, &ref, &qs.z);
+    quat_reduce(&qs);
+    apply_quaternion_action_to_theta(&tq, &qs);
+    apply_small_quaternion_action_to_theta(&tr, qi);
+    canonicalize_theta(&tr);
+    fprintf(out, "[CHECK] small quaternion action : %s\n\n", memcmp(&tq, &tr, sizeof(tq)) == 0 ? "OK" : "MISMATCH");
+    BENCH(&B, "fp2_mul_small", 100, fp2_mul_small(&tr.b, &tr.b, qi[3]));
+    BENCH(&B, "fp2_mul_scalar", 100, fp2_mul_scalar(&tr.b, &tr.b, &qs.z));
+    BENCH(&B, "apply_small_quaternion_action", 1, apply_small_quaternion_action_to_theta(&tr, qi));
+
+    // Quaternion algebra over F_p
+    quaternion_t qa, qb, qc;
+    oriint_set(&qa.w, &am); oriint_set(&qa.x, &bm); oriint_set(&qa.y, &xs[2].re); oriint_set(&qa.z, &xs[3].re);
+    qb = qa;
+    quat_reduce(&qa); quat_reduce(&qb);
+    BENCH(&B, "quat_mul", 100, quat_mul(&qc, &qa, &qb); qa = qc);
+
+    // Single-limb layer
+    bench_old_run(&B);
+
+    if (json) {
+        bench_json(stdout, &B, oriint_cpu_ifma ? "mulx+ifma" : oriint_cpu_mulx ? "mulx" : "generic");
+    } else {
+        bench_print(stdout, &B);
+        printf("  (checksum %016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 ")\n", res.bitsu64[0], resv.bitsu64[0], ref.bitsu64[0], ys[0].re.bitsu64[0], th.b.re.bitsu64[0]);
+        printf("  (checksum %016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 ")\n", a1.bitsu64[0], a3.bitsu64[0], a5.bitsu64[0], pa.bitsu64[0], qa.w.bitsu64[0]);
+        printf("==============================================================\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+/* * ORISIGN V9.7 - SINGLE-LIMB LAYER BENCHMARK
+ * fp_old.h, theta_old.h and quaternion_old.h, reported through bench.h.
+ */
+
+#include <stdint.h>
+
+#include "constants.h"
+#include "types.h"
+#include "fp_old.h"
+#include "quaternion_old.h"
+#include "theta_old.h"
+#include "bench_old.h"
+
+void bench_old_run(bench_t *B) {
+    uint64_t x = 12345, y = 54321;
+    fp2old_t u = { 1234, 5678 }, v = { 4321, 8765 };
+    Quaternion q = { 1, 2, 3, 4 }, r = { 5, 6, 7, 8 };
+    ThetaNullPoint_Fp2 T = { { 1, 2 }, { 3, 4 }, { 5, 6 }, { 7, 8 } };
+    volatile uint64_t sink;
+
+    // Dependent chains: each result feeds the next call
+    BENCH(B, "old fp_add", 1000, x = fp_add(x, y));
+    BENCH(B, "old fp_mul", 1000, x = fp_mul(x, y));
+    BENCH(B, "old fp_inv", 10, x = fp_inv(x));
+    BENCH(B, "old fp_inv_vartime", 10, x = fp_inv_vartime(x));
+    BENCH(B, "old fp_sqrt", 10, x = fp_sqrt(x) + 1);
+    BENCH(B, "old fp2_mul", 1000, u = fp2_mul(u, v));
+    BENCH(B, "old fp2_inv", 10, u = fp2_inv(u));
+    BENCH(B, "old fp2_mul_scalar", 1000, u = fp2_mul_scalar(u, -158));
+    BENCH(B, "old fp2_mul_small", 1000, u = fp2_mul_small(u, -158));
+    // Every term depends on u so nothing is hoisted out of the loop
+    const uint64_t s4[4] = { 11, 22, 33, 44 };
+    fp2old_t w;
+    BENCH(B, "old fp2_mul_scalar + add/sub (x4)", 1000, w.re = u.im; w.im = u.re;
+          u = fp2_add(fp2_sub(fp2_mul_scalar(u, s4[0]), fp2_mul_scalar(w, s4[1])),
+                      fp2_sub(fp2_mul_scalar(w, s4[2]), fp2_mul_scalar(u, s4[3]))));
+    BENCH(B, "old fp2_mul_sum (4 terms)", 1000, w.re = u.im; w.im = u.re;
+          u = fp2_mul_sum((const fp2old_t[4]){ u, w, w, u }, s4, 4, 0xa));
+    BENCH(B, "old quat_mul", 1000, q = quat_mul(q, r));
+    BENCH(B, "old eval_sq_isogeny_velu_theta", 100, eval_sq_isogeny_velu_theta(&T, T.b));
+    BENCH(B, "old canonicalize_theta", 100, canonicalize_theta(&T));
+    BENCH(B, "old apply_quaternion_to_theta", 1, apply_quaternion_to_theta_chain(&T, x));
+    BENCH(B, "old apply_quaternion_to_theta (canonical)", 1, apply_quaternion_to_theta_chain_canonical(&T, x));
+
+    sink = x ^ u.re ^ q.w ^ T.a.re;
+    (void)sink;
+}
@@ -0,0 +1,6 @@
+#pragma once
+#include "bench.h"
+
+// Single-limb layer (fp_old.h, theta_old.h, quaternion_old.h) timed in its
+// own translation unit, bench_old.c: its names clash with fp.h.
+void bench_old_run(bench_t *B);
@@ -0,0 +1,29 @@
+/* * ORISIGN V9.7 - PORTABLE BACKEND FOR THE FIELD BENCHMARK
+ * The same kernels as bench_field.c, compiled with ORIINT_PORTABLE.
+ */
+
+#define ORIINT_PORTABLE
+
+#include "int.h"
+#include "fp.h"
+#include "bench_portable.h"
+
+void portable_fp_mul_chain(oriint_t *RES, oriint_t *b, int n) {
+    for (int i = 0; i < n; i++)
+        fp_mul(RES, RES, b);
+}
+
+void portable_fp_sqr_chain(oriint_t *RES, int n) {
+    for (int i = 0; i < n; i++)
+        fp_sqr(RES, RES);
+}
+
+void portable_modmul_chain(oriint_t *RES, oriint_t *b, int n) {
+    for (int i = 0; i < n; i++)
+        oriint_modmul(RES, b);
+}
+
+void portable_modinv_chain(oriint_t *RES, int n) {
+    for (int i = 0; i < n; i++)
+        oriint_modinv(RES);
+}
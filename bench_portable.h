@@ -0,0 +1,10 @@
+#pragma once
+#include "types.h"
+
+// int.h/fp.h built with ORIINT_PORTABLE in their own translation unit
+// (bench_portable.c), so both backends can run in one bench binary. Each
+// chain feeds its result back in, as the bench_field.c loops do.
+void portable_fp_mul_chain(oriint_t *RES, oriint_t *b, int n);
+void portable_fp_sqr_chain(oriint_t *RES, int n);
+void portable_modmul_chain(oriint_t *RES, oriint_t *b, int n);
+void portable_modinv_chain(oriint_t *RES, int n);
@@ -3,8 +3,10 @@
 
 #define NBLOCK_OLD 1
 #define NBLOCK 5
+#define NBLOCK_PACKED 4   // reduced elements at rest, P < 2^251
 #define SQ_POWER_OLD 8
 #define SQ_POWER 256
+#define THETA_BATCH_LANES 4   // theta points per theta_batch_t, a multiple of 4
 #define DOMAIN_SEP "ORISIGN-V9.7-NIST-PQC-2026"
 #define HASHES_BYTES 32
 
@@ -0,0 +1,38 @@
+/* * ORISIGN V9.7 - F_p constants for P = 0x4ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff
+ * Generated by gen_field.py lvl1, do not edit.
+ */
+
+#include "field_lvl1.h"
+
+const uint64_t LVL1_MM64 = 0x0000000000000001;
+const lvl1_fp_t LVL1_P = {
+    .bitsu64 = {
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0x04ffffffffffffff
+    }
+};
+const lvl1_fp_t LVL1_R1 = {
+    .bitsu64 = {
+        0x0000000000000033,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0100000000000000
+    }
+};
+const lvl1_fp_t LVL1_R2 = {
+    .bitsu64 = {
+        0x3333333333333d70,
+        0x3333333333333333,
+        0x3333333333333333,
+        0x0333333333333333
+    }
+};
+// P - 2 in base 2^4, most significant digit first
+const uint8_t LVL1_INV_DIGITS[63] = {
+    4, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 13,
+};
@@ -0,0 +1,319 @@
+/* * ORISIGN V9.7 - F_p for P = 0x4ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff
+ * Generated by gen_field.py lvl1, do not edit.
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) && !defined(ORIINT_PORTABLE)
+#include <x86intrin.h>
+
+static inline unsigned char lvl1_addc(unsigned char c, uint64_t a, uint64_t b, uint64_t *d) {
+    return _addcarry_u64(c, a, b, (unsigned long long *)d);
+}
+
+static inline unsigned char lvl1_subb(unsigned char c, uint64_t a, uint64_t b, uint64_t *d) {
+    return _subborrow_u64(c, a, b, (unsigned long long *)d);
+}
+
+#else
+
+static inline unsigned char lvl1_addc(unsigned char c, uint64_t a, uint64_t b, uint64_t *d) {
+    uint64_t s;
+    bool c1 = __builtin_add_overflow(a, b, &s);
+    bool c2 = __builtin_add_overflow(s, (uint64_t)c, d);
+
+    return c1 | c2;
+}
+
+static inline unsigned char lvl1_subb(unsigned char c, uint64_t a, uint64_t b, uint64_t *d) {
+    uint64_t s;
+    bool c1 = __builtin_sub_overflow(a, b, &s);
+    bool c2 = __builtin_sub_overflow(s, (uint64_t)c, d);
+
+    return c1 | c2;
+}
+
+#endif
+
+#define LVL1_NBLOCK 4
+#define LVL1_BITS 251
+
+typedef union {
+    uint64_t bitsu64[4];
+    int64_t bits64[4];
+} lvl1_fp_t;
+
+extern const lvl1_fp_t LVL1_P;
+extern const lvl1_fp_t LVL1_R1;
+extern const lvl1_fp_t LVL1_R2;
+extern const uint64_t LVL1_MM64;
+extern const uint8_t LVL1_INV_DIGITS[63];
+
+// [0, 2P) -> [0, P), constant time
+static inline void lvl1_fp_reduce(lvl1_fp_t *RES) {
+    lvl1_fp_t t;
+    uint64_t m;
+    unsigned char c = 0;
+
+    c = lvl1_subb(c, RES->bitsu64[0], LVL1_P.bitsu64[0], &t.bitsu64[0]);
+    c = lvl1_subb(c, RES->bitsu64[1], LVL1_P.bitsu64[1], &t.bitsu64[1]);
+    c = lvl1_subb(c, RES->bitsu64[2], LVL1_P.bitsu64[2], &t.bitsu64[2]);
+    c = lvl1_subb(c, RES->bitsu64[3], LVL1_P.bitsu64[3], &t.bitsu64[3]);
+    m = -(uint64_t)c;
+    RES->bitsu64[0] = (RES->bitsu64[0] & m) | (t.bitsu64[0] & ~m);
+    RES->bitsu64[1] = (RES->bitsu64[1] & m) | (t.bitsu64[1] & ~m);
+    RES->bitsu64[2] = (RES->bitsu64[2] & m) | (t.bitsu64[2] & ~m);
+    RES->bitsu64[3] = (RES->bitsu64[3] & m) | (t.bitsu64[3] & ~m);
+}
+
+static inline void lvl1_fp_add(lvl1_fp_t *RES, const lvl1_fp_t *a, const lvl1_fp_t *b) {
+    unsigned char c = 0;
+
+    c = lvl1_addc(c, a->bitsu64[0], b->bitsu64[0], &RES->bitsu64[0]);
+    c = lvl1_addc(c, a->bitsu64[1], b->bitsu64[1], &RES->bitsu64[1]);
+    c = lvl1_addc(c, a->bitsu64[2], b->bitsu64[2], &RES->bitsu64[2]);
+    c = lvl1_addc(c, a->bitsu64[3], b->bitsu64[3], &RES->bitsu64[3]);
+    lvl1_fp_reduce(RES);
+}
+
+static inline void lvl1_fp_sub(lvl1_fp_t *RES, const lvl1_fp_t *a, const lvl1_fp_t *b) {
+    uint64_t m;
+    unsigned char c = 0;
+
+    c = lvl1_subb(c, a->bitsu64[0], b->bitsu64[0], &RES->bitsu64[0]);
+    c = lvl1_subb(c, a->bitsu64[1], b->bitsu64[1], &RES->bitsu64[1]);
+    c = lvl1_subb(c, a->bitsu64[2], b->bitsu64[2], &RES->bitsu64[2]);
+    c = lvl1_subb(c, a->bitsu64[3], b->bitsu64[3], &RES->bitsu64[3]);
+    m = -(uint64_t)c;
+    c = 0;
+    c = lvl1_addc(c, RES->bitsu64[0], LVL1_P.bitsu64[0] & m, &RES->bitsu64[0]);
+    c = lvl1_addc(c, RES->bitsu64[1], LVL1_P.bitsu64[1] & m, &RES->bitsu64[1]);
+    c = lvl1_addc(c, RES->bitsu64[2], LVL1_P.bitsu64[2] & m, &RES->bitsu64[2]);
+    c = lvl1_addc(c, RES->bitsu64[3], LVL1_P.bitsu64[3] & m, &RES->bitsu64[3]);
+}
+
+static inline void lvl1_fp_neg(lvl1_fp_t *RES, const lvl1_fp_t *a) {
+    const lvl1_fp_t z = { { 0 } };
+
+    lvl1_fp_sub(RES, &z, a);
+}
+
+// r = a * b, 8 limbs
+static inline void lvl1_fp_mul_wide(uint64_t *r, const lvl1_fp_t *a, const lvl1_fp_t *b) {
+    unsigned __int128 t;
+    uint64_t c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[0]; r[0] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[0] + c; r[1] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[0] + c; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[0] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[4] = c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[1] + r[1]; r[1] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[1] + r[2] + c; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[1] + r[3] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[1] + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[5] = c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[2] + r[2]; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[2] + r[3] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[2] + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[2] + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[6] = c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[3] + r[3]; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[3] + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[3] + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[3] + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[7] = c;
+}
+
+// r = a^2, 8 limbs: cross products once, doubled, plus the squares
+static inline void lvl1_fp_sqr_wide(uint64_t *r, const lvl1_fp_t *a) {
+    unsigned __int128 t;
+    uint64_t c;
+    unsigned char k = 0;
+
+    r[0] = 0;
+    r[7] = 0;
+
+    t = (unsigned __int128)a->bitsu64[1] * a->bitsu64[0]; r[1] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * a->bitsu64[0] + c; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * a->bitsu64[0] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[4] = c;
+
+    t = (unsigned __int128)a->bitsu64[2] * a->bitsu64[1] + r[3]; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * a->bitsu64[1] + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[5] = c;
+
+    t = (unsigned __int128)a->bitsu64[3] * a->bitsu64[2] + r[5]; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[6] = c;
+
+    r[7] = (r[7] << 1) | (r[6] >> 63);
+    r[6] = (r[6] << 1) | (r[5] >> 63);
+    r[5] = (r[5] << 1) | (r[4] >> 63);
+    r[4] = (r[4] << 1) | (r[3] >> 63);
+    r[3] = (r[3] << 1) | (r[2] >> 63);
+    r[2] = (r[2] << 1) | (r[1] >> 63);
+    r[1] = (r[1] << 1) | (r[0] >> 63);
+    r[0] = 0;
+
+    t = (unsigned __int128)a->bitsu64[0] * a->bitsu64[0];
+    k = lvl1_addc(k, r[0], (uint64_t)t, &r[0]);
+    k = lvl1_addc(k, r[1], (uint64_t)(t >> 64), &r[1]);
+    t = (unsigned __int128)a->bitsu64[1] * a->bitsu64[1];
+    k = lvl1_addc(k, r[2], (uint64_t)t, &r[2]);
+    k = lvl1_addc(k, r[3], (uint64_t)(t >> 64), &r[3]);
+    t = (unsigned __int128)a->bitsu64[2] * a->bitsu64[2];
+    k = lvl1_addc(k, r[4], (uint64_t)t, &r[4]);
+    k = lvl1_addc(k, r[5], (uint64_t)(t >> 64), &r[5]);
+    t = (unsigned __int128)a->bitsu64[3] * a->bitsu64[3];
+    k = lvl1_addc(k, r[6], (uint64_t)t, &r[6]);
+    k = lvl1_addc(k, r[7], (uint64_t)(t >> 64), &r[7]);
+}
+
+// Montgomery reduction r * 2^-256 mod P into [0, P); r < P * 2^256 is destroyed
+static inline void lvl1_fp_redc(lvl1_fp_t *RES, uint64_t *r) {
+    unsigned __int128 t;
+    uint64_t q, c, e = 0;
+
+    q = r[0];
+    t = ((unsigned __int128)q << 64) - q + r[0]; r[0] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[1] + c; r[1] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[2] + c; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL1_P.bitsu64[3] + r[3] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[4] + c + e; r[4] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    q = r[1];
+    t = ((unsigned __int128)q << 64) - q + r[1]; r[1] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[2] + c; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[3] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL1_P.bitsu64[3] + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[5] + c + e; r[5] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    q = r[2];
+    t = ((unsigned __int128)q << 64) - q + r[2]; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[3] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL1_P.bitsu64[3] + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[6] + c + e; r[6] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    q = r[3];
+    t = ((unsigned __int128)q << 64) - q + r[3]; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL1_P.bitsu64[3] + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[7] + c + e; r[7] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    RES->bitsu64[0] = r[4];
+    RES->bitsu64[1] = r[5];
+    RES->bitsu64[2] = r[6];
+    RES->bitsu64[3] = r[7];
+    lvl1_fp_reduce(RES);
+}
+
+// RES = a * b * 2^-256 mod P, a, b < P
+static inline void lvl1_fp_mul(lvl1_fp_t *RES, const lvl1_fp_t *a, const lvl1_fp_t *b) {
+    unsigned __int128 t;
+    uint64_t q, c, t0 = 0, t1 = 0, t2 = 0, t3 = 0, t4 = 0, t5 = 0;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[0] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[0] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[0] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[0] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t4 + c; t4 = (uint64_t)t; t5 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL1_P.bitsu64[3] + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t4 + c; t3 = (uint64_t)t; t4 = t5 + (uint64_t)(t >> 64);
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[1] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[1] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[1] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[1] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t4 + c; t4 = (uint64_t)t; t5 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL1_P.bitsu64[3] + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t4 + c; t3 = (uint64_t)t; t4 = t5 + (uint64_t)(t >> 64);
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[2] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[2] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[2] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[2] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t4 + c; t4 = (uint64_t)t; t5 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL1_P.bitsu64[3] + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t4 + c; t3 = (uint64_t)t; t4 = t5 + (uint64_t)(t >> 64);
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[3] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[3] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[3] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[3] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t4 + c; t4 = (uint64_t)t; t5 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL1_P.bitsu64[3] + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t4 + c; t3 = (uint64_t)t; t4 = t5 + (uint64_t)(t >> 64);
+
+    RES->bitsu64[0] = t0;
+    RES->bitsu64[1] = t1;
+    RES->bitsu64[2] = t2;
+    RES->bitsu64[3] = t3;
+    lvl1_fp_reduce(RES);
+}
+
+static inline void lvl1_fp_sqr(lvl1_fp_t *RES, const lvl1_fp_t *a) {
+    uint64_t r[8];
+
+    lvl1_fp_sqr_wide(r, a);
+    lvl1_fp_redc(RES, r);
+}
+
+static inline void lvl1_fp_to_mont(lvl1_fp_t *RES, const lvl1_fp_t *a) {
+    lvl1_fp_mul(RES, a, &LVL1_R2);
+}
+
+static inline void lvl1_fp_from_mont(lvl1_fp_t *RES, const lvl1_fp_t *a) {
+    uint64_t r[8] = { 0 };
+
+    r[0] = a->bitsu64[0];
+    r[1] = a->bitsu64[1];
+    r[2] = a->bitsu64[2];
+    r[3] = a->bitsu64[3];
+    lvl1_fp_redc(RES, r);
+}
+
+// a^(P-2), Montgomery form in and out; 0 maps to 0. The exponent is
+// public, so the 4-bit window digits drive the loop directly.
+static inline void lvl1_fp_inv(lvl1_fp_t *RES, const lvl1_fp_t *a) {
+    lvl1_fp_t tab[16];
+    lvl1_fp_t x;
+
+    tab[0] = LVL1_R1;
+    tab[1] = *a;
+    for (int i = 2; i < 16; i++)
+        lvl1_fp_mul(&tab[i], &tab[i - 1], a);
+
+    x = tab[LVL1_INV_DIGITS[0]];
+    for (int i = 1; i < 63; i++) {
+        lvl1_fp_sqr(&x, &x);
+        lvl1_fp_sqr(&x, &x);
+        lvl1_fp_sqr(&x, &x);
+        lvl1_fp_sqr(&x, &x);
+        if (LVL1_INV_DIGITS[i])
+            lvl1_fp_mul(&x, &x, &tab[LVL1_INV_DIGITS[i]]);
+    }
+    *RES = x;
+}
@@ -0,0 +1,46 @@
+/* * ORISIGN V9.7 - F_p constants for P = 0x40ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff
+ * Generated by gen_field.py lvl3, do not edit.
+ */
+
+#include "field_lvl3.h"
+
+const uint64_t LVL3_MM64 = 0x0000000000000001;
+const lvl3_fp_t LVL3_P = {
+    .bitsu64 = {
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0x40ffffffffffffff
+    }
+};
+const lvl3_fp_t LVL3_R1 = {
+    .bitsu64 = {
+        0x0000000000000003,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x3d00000000000000
+    }
+};
+const lvl3_fp_t LVL3_R2 = {
+    .bitsu64 = {
+        0x3f03f03f03f03f13,
+        0x03f03f03f03f03f0,
+        0xf03f03f03f03f03f,
+        0x3f03f03f03f03f03,
+        0x03f03f03f03f03f0,
+        0x1d3f03f03f03f03f
+    }
+};
+// P - 2 in base 2^4, most significant digit first
+const uint8_t LVL3_INV_DIGITS[96] = {
+    4, 0, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 13,
+};
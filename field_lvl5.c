@@ -0,0 +1,54 @@
+/* * ORISIGN V9.7 - F_p constants for P = 0x1afffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff
+ * Generated by gen_field.py lvl5, do not edit.
+ */
+
+#include "field_lvl5.h"
+
+const uint64_t LVL5_MM64 = 0x0000000000000001;
+const lvl5_fp_t LVL5_P = {
+    .bitsu64 = {
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0x01afffffffffffff
+    }
+};
+const lvl5_fp_t LVL5_R1 = {
+    .bitsu64 = {
+        0x0000000000000097,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0130000000000000
+    }
+};
+const lvl5_fp_t LVL5_R2 = {
+    .bitsu64 = {
+        0xed097b425ed0f19a,
+        0x097b425ed097b425,
+        0x7b425ed097b425ed,
+        0x425ed097b425ed09,
+        0x5ed097b425ed097b,
+        0xd097b425ed097b42,
+        0x97b425ed097b425e,
+        0x0045ed097b425ed0
+    }
+};
+// P - 2 in base 2^4, most significant digit first
+const uint8_t LVL5_INV_DIGITS[127] = {
+    1, 10, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+    15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 13,
+};
@@ -0,0 +1,629 @@
+/* * ORISIGN V9.7 - F_p for P = 0x1afffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff
+ * Generated by gen_field.py lvl5, do not edit.
+ */
+
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) && !defined(ORIINT_PORTABLE)
+#include <x86intrin.h>
+
+static inline unsigned char lvl5_addc(unsigned char c, uint64_t a, uint64_t b, uint64_t *d) {
+    return _addcarry_u64(c, a, b, (unsigned long long *)d);
+}
+
+static inline unsigned char lvl5_subb(unsigned char c, uint64_t a, uint64_t b, uint64_t *d) {
+    return _subborrow_u64(c, a, b, (unsigned long long *)d);
+}
+
+#else
+
+static inline unsigned char lvl5_addc(unsigned char c, uint64_t a, uint64_t b, uint64_t *d) {
+    uint64_t s;
+    bool c1 = __builtin_add_overflow(a, b, &s);
+    bool c2 = __builtin_add_overflow(s, (uint64_t)c, d);
+
+    return c1 | c2;
+}
+
+static inline unsigned char lvl5_subb(unsigned char c, uint64_t a, uint64_t b, uint64_t *d) {
+    uint64_t s;
+    bool c1 = __builtin_sub_overflow(a, b, &s);
+    bool c2 = __builtin_sub_overflow(s, (uint64_t)c, d);
+
+    return c1 | c2;
+}
+
+#endif
+
+#define LVL5_NBLOCK 8
+#define LVL5_BITS 505
+
+typedef union {
+    uint64_t bitsu64[8];
+    int64_t bits64[8];
+} lvl5_fp_t;
+
+extern const lvl5_fp_t LVL5_P;
+extern const lvl5_fp_t LVL5_R1;
+extern const lvl5_fp_t LVL5_R2;
+extern const uint64_t LVL5_MM64;
+extern const uint8_t LVL5_INV_DIGITS[127];
+
+// [0, 2P) -> [0, P), constant time
+static inline void lvl5_fp_reduce(lvl5_fp_t *RES) {
+    lvl5_fp_t t;
+    uint64_t m;
+    unsigned char c = 0;
+
+    c = lvl5_subb(c, RES->bitsu64[0], LVL5_P.bitsu64[0], &t.bitsu64[0]);
+    c = lvl5_subb(c, RES->bitsu64[1], LVL5_P.bitsu64[1], &t.bitsu64[1]);
+    c = lvl5_subb(c, RES->bitsu64[2], LVL5_P.bitsu64[2], &t.bitsu64[2]);
+    c = lvl5_subb(c, RES->bitsu64[3], LVL5_P.bitsu64[3], &t.bitsu64[3]);
+    c = lvl5_subb(c, RES->bitsu64[4], LVL5_P.bitsu64[4], &t.bitsu64[4]);
+    c = lvl5_subb(c, RES->bitsu64[5], LVL5_P.bitsu64[5], &t.bitsu64[5]);
+    c = lvl5_subb(c, RES->bitsu64[6], LVL5_P.bitsu64[6], &t.bitsu64[6]);
+    c = lvl5_subb(c, RES->bitsu64[7], LVL5_P.bitsu64[7], &t.bitsu64[7]);
+    m = -(uint64_t)c;
+    RES->bitsu64[0] = (RES->bitsu64[0] & m) | (t.bitsu64[0] & ~m);
+    RES->bitsu64[1] = (RES->bitsu64[1] & m) | (t.bitsu64[1] & ~m);
+    RES->bitsu64[2] = (RES->bitsu64[2] & m) | (t.bitsu64[2] & ~m);
+    RES->bitsu64[3] = (RES->bitsu64[3] & m) | (t.bitsu64[3] & ~m);
+    RES->bitsu64[4] = (RES->bitsu64[4] & m) | (t.bitsu64[4] & ~m);
+    RES->bitsu64[5] = (RES->bitsu64[5] & m) | (t.bitsu64[5] & ~m);
+    RES->bitsu64[6] = (RES->bitsu64[6] & m) | (t.bitsu64[6] & ~m);
+    RES->bitsu64[7] = (RES->bitsu64[7] & m) | (t.bitsu64[7] & ~m);
+}
+
+static inline void lvl5_fp_add(lvl5_fp_t *RES, const lvl5_fp_t *a, const lvl5_fp_t *b) {
+    unsigned char c = 0;
+
+    c = lvl5_addc(c, a->bitsu64[0], b->bitsu64[0], &RES->bitsu64[0]);
+    c = lvl5_addc(c, a->bitsu64[1], b->bitsu64[1], &RES->bitsu64[1]);
+    c = lvl5_addc(c, a->bitsu64[2], b->bitsu64[2], &RES->bitsu64[2]);
+    c = lvl5_addc(c, a->bitsu64[3], b->bitsu64[3], &RES->bitsu64[3]);
+    c = lvl5_addc(c, a->bitsu64[4], b->bitsu64[4], &RES->bitsu64[4]);
+    c = lvl5_addc(c, a->bitsu64[5], b->bitsu64[5], &RES->bitsu64[5]);
+    c = lvl5_addc(c, a->bitsu64[6], b->bitsu64[6], &RES->bitsu64[6]);
+    c = lvl5_addc(c, a->bitsu64[7], b->bitsu64[7], &RES->bitsu64[7]);
+    lvl5_fp_reduce(RES);
+}
+
+static inline void lvl5_fp_sub(lvl5_fp_t *RES, const lvl5_fp_t *a, const lvl5_fp_t *b) {
+    uint64_t m;
+    unsigned char c = 0;
+
+    c = lvl5_subb(c, a->bitsu64[0], b->bitsu64[0], &RES->bitsu64[0]);
+    c = lvl5_subb(c, a->bitsu64[1], b->bitsu64[1], &RES->bitsu64[1]);
+    c = lvl5_subb(c, a->bitsu64[2], b->bitsu64[2], &RES->bitsu64[2]);
+    c = lvl5_subb(c, a->bitsu64[3], b->bitsu64[3], &RES->bitsu64[3]);
+    c = lvl5_subb(c, a->bitsu64[4], b->bitsu64[4], &RES->bitsu64[4]);
+    c = lvl5_subb(c, a->bitsu64[5], b->bitsu64[5], &RES->bitsu64[5]);
+    c = lvl5_subb(c, a->bitsu64[6], b->bitsu64[6], &RES->bitsu64[6]);
+    c = lvl5_subb(c, a->bitsu64[7], b->bitsu64[7], &RES->bitsu64[7]);
+    m = -(uint64_t)c;
+    c = 0;
+    c = lvl5_addc(c, RES->bitsu64[0], LVL5_P.bitsu64[0] & m, &RES->bitsu64[0]);
+    c = lvl5_addc(c, RES->bitsu64[1], LVL5_P.bitsu64[1] & m, &RES->bitsu64[1]);
+    c = lvl5_addc(c, RES->bitsu64[2], LVL5_P.bitsu64[2] & m, &RES->bitsu64[2]);
+    c = lvl5_addc(c, RES->bitsu64[3], LVL5_P.bitsu64[3] & m, &RES->bitsu64[3]);
+    c = lvl5_addc(c, RES->bitsu64[4], LVL5_P.bitsu64[4] & m, &RES->bitsu64[4]);
+    c = lvl5_addc(c, RES->bitsu64[5], LVL5_P.bitsu64[5] & m, &RES->bitsu64[5]);
+    c = lvl5_addc(c, RES->bitsu64[6], LVL5_P.bitsu64[6] & m, &RES->bitsu64[6]);
+    c = lvl5_addc(c, RES->bitsu64[7], LVL5_P.bitsu64[7] & m, &RES->bitsu64[7]);
+}
+
+static inline void lvl5_fp_neg(lvl5_fp_t *RES, const lvl5_fp_t *a) {
+    const lvl5_fp_t z = { { 0 } };
+
+    lvl5_fp_sub(RES, &z, a);
+}
+
+// r = a * b, 16 limbs
+static inline void lvl5_fp_mul_wide(uint64_t *r, const lvl5_fp_t *a, const lvl5_fp_t *b) {
+    unsigned __int128 t;
+    uint64_t c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[0]; r[0] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[0] + c; r[1] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[0] + c; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[0] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[0] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[0] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[0] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[0] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[8] = c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[1] + r[1]; r[1] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[1] + r[2] + c; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[1] + r[3] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[1] + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[1] + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[1] + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[1] + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[1] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[9] = c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[2] + r[2]; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[2] + r[3] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[2] + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[2] + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[2] + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[2] + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[2] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[2] + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[10] = c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[3] + r[3]; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[3] + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[3] + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[3] + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[3] + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[3] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[3] + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[3] + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[11] = c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[4] + r[4]; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[4] + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[4] + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[4] + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[4] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[4] + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[4] + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[4] + r[11] + c; r[11] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[12] = c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[5] + r[5]; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[5] + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[5] + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[5] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[5] + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[5] + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[5] + r[11] + c; r[11] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[5] + r[12] + c; r[12] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[13] = c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[6] + r[6]; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[6] + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[6] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[6] + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[6] + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[6] + r[11] + c; r[11] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[6] + r[12] + c; r[12] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[6] + r[13] + c; r[13] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[14] = c;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[7] + r[7]; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[7] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[7] + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[7] + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[7] + r[11] + c; r[11] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[7] + r[12] + c; r[12] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[7] + r[13] + c; r[13] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[7] + r[14] + c; r[14] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[15] = c;
+}
+
+// r = a^2, 16 limbs: cross products once, doubled, plus the squares
+static inline void lvl5_fp_sqr_wide(uint64_t *r, const lvl5_fp_t *a) {
+    unsigned __int128 t;
+    uint64_t c;
+    unsigned char k = 0;
+
+    r[0] = 0;
+    r[15] = 0;
+
+    t = (unsigned __int128)a->bitsu64[1] * a->bitsu64[0]; r[1] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * a->bitsu64[0] + c; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * a->bitsu64[0] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * a->bitsu64[0] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * a->bitsu64[0] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * a->bitsu64[0] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * a->bitsu64[0] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[8] = c;
+
+    t = (unsigned __int128)a->bitsu64[2] * a->bitsu64[1] + r[3]; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * a->bitsu64[1] + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * a->bitsu64[1] + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * a->bitsu64[1] + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * a->bitsu64[1] + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * a->bitsu64[1] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[9] = c;
+
+    t = (unsigned __int128)a->bitsu64[3] * a->bitsu64[2] + r[5]; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * a->bitsu64[2] + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * a->bitsu64[2] + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * a->bitsu64[2] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * a->bitsu64[2] + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[10] = c;
+
+    t = (unsigned __int128)a->bitsu64[4] * a->bitsu64[3] + r[7]; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * a->bitsu64[3] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * a->bitsu64[3] + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * a->bitsu64[3] + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[11] = c;
+
+    t = (unsigned __int128)a->bitsu64[5] * a->bitsu64[4] + r[9]; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * a->bitsu64[4] + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * a->bitsu64[4] + r[11] + c; r[11] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[12] = c;
+
+    t = (unsigned __int128)a->bitsu64[6] * a->bitsu64[5] + r[11]; r[11] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * a->bitsu64[5] + r[12] + c; r[12] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[13] = c;
+
+    t = (unsigned __int128)a->bitsu64[7] * a->bitsu64[6] + r[13]; r[13] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    r[14] = c;
+
+    r[15] = (r[15] << 1) | (r[14] >> 63);
+    r[14] = (r[14] << 1) | (r[13] >> 63);
+    r[13] = (r[13] << 1) | (r[12] >> 63);
+    r[12] = (r[12] << 1) | (r[11] >> 63);
+    r[11] = (r[11] << 1) | (r[10] >> 63);
+    r[10] = (r[10] << 1) | (r[9] >> 63);
+    r[9] = (r[9] << 1) | (r[8] >> 63);
+    r[8] = (r[8] << 1) | (r[7] >> 63);
+    r[7] = (r[7] << 1) | (r[6] >> 63);
+    r[6] = (r[6] << 1) | (r[5] >> 63);
+    r[5] = (r[5] << 1) | (r[4] >> 63);
+    r[4] = (r[4] << 1) | (r[3] >> 63);
+    r[3] = (r[3] << 1) | (r[2] >> 63);
+    r[2] = (r[2] << 1) | (r[1] >> 63);
+    r[1] = (r[1] << 1) | (r[0] >> 63);
+    r[0] = 0;
+
+    t = (unsigned __int128)a->bitsu64[0] * a->bitsu64[0];
+    k = lvl5_addc(k, r[0], (uint64_t)t, &r[0]);
+    k = lvl5_addc(k, r[1], (uint64_t)(t >> 64), &r[1]);
+    t = (unsigned __int128)a->bitsu64[1] * a->bitsu64[1];
+    k = lvl5_addc(k, r[2], (uint64_t)t, &r[2]);
+    k = lvl5_addc(k, r[3], (uint64_t)(t >> 64), &r[3]);
+    t = (unsigned __int128)a->bitsu64[2] * a->bitsu64[2];
+    k = lvl5_addc(k, r[4], (uint64_t)t, &r[4]);
+    k = lvl5_addc(k, r[5], (uint64_t)(t >> 64), &r[5]);
+    t = (unsigned __int128)a->bitsu64[3] * a->bitsu64[3];
+    k = lvl5_addc(k, r[6], (uint64_t)t, &r[6]);
+    k = lvl5_addc(k, r[7], (uint64_t)(t >> 64), &r[7]);
+    t = (unsigned __int128)a->bitsu64[4] * a->bitsu64[4];
+    k = lvl5_addc(k, r[8], (uint64_t)t, &r[8]);
+    k = lvl5_addc(k, r[9], (uint64_t)(t >> 64), &r[9]);
+    t = (unsigned __int128)a->bitsu64[5] * a->bitsu64[5];
+    k = lvl5_addc(k, r[10], (uint64_t)t, &r[10]);
+    k = lvl5_addc(k, r[11], (uint64_t)(t >> 64), &r[11]);
+    t = (unsigned __int128)a->bitsu64[6] * a->bitsu64[6];
+    k = lvl5_addc(k, r[12], (uint64_t)t, &r[12]);
+    k = lvl5_addc(k, r[13], (uint64_t)(t >> 64), &r[13]);
+    t = (unsigned __int128)a->bitsu64[7] * a->bitsu64[7];
+    k = lvl5_addc(k, r[14], (uint64_t)t, &r[14]);
+    k = lvl5_addc(k, r[15], (uint64_t)(t >> 64), &r[15]);
+}
+
+// Montgomery reduction r * 2^-512 mod P into [0, P); r < P * 2^512 is destroyed
+static inline void lvl5_fp_redc(lvl5_fp_t *RES, uint64_t *r) {
+    unsigned __int128 t;
+    uint64_t q, c, e = 0;
+
+    q = r[0];
+    t = ((unsigned __int128)q << 64) - q + r[0]; r[0] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[1] + c; r[1] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[2] + c; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[3] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[8] + c + e; r[8] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    q = r[1];
+    t = ((unsigned __int128)q << 64) - q + r[1]; r[1] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[2] + c; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[3] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[9] + c + e; r[9] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    q = r[2];
+    t = ((unsigned __int128)q << 64) - q + r[2]; r[2] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[3] + c; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[10] + c + e; r[10] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    q = r[3];
+    t = ((unsigned __int128)q << 64) - q + r[3]; r[3] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[4] + c; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[11] + c + e; r[11] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    q = r[4];
+    t = ((unsigned __int128)q << 64) - q + r[4]; r[4] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[5] + c; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + r[11] + c; r[11] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[12] + c + e; r[12] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    q = r[5];
+    t = ((unsigned __int128)q << 64) - q + r[5]; r[5] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[6] + c; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[11] + c; r[11] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + r[12] + c; r[12] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[13] + c + e; r[13] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    q = r[6];
+    t = ((unsigned __int128)q << 64) - q + r[6]; r[6] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[7] + c; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[11] + c; r[11] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[12] + c; r[12] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + r[13] + c; r[13] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[14] + c + e; r[14] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    q = r[7];
+    t = ((unsigned __int128)q << 64) - q + r[7]; r[7] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[8] + c; r[8] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[9] + c; r[9] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[10] + c; r[10] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[11] + c; r[11] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[12] + c; r[12] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + r[13] + c; r[13] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + r[14] + c; r[14] = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)r[15] + c + e; r[15] = (uint64_t)t; e = (uint64_t)(t >> 64);
+
+    RES->bitsu64[0] = r[8];
+    RES->bitsu64[1] = r[9];
+    RES->bitsu64[2] = r[10];
+    RES->bitsu64[3] = r[11];
+    RES->bitsu64[4] = r[12];
+    RES->bitsu64[5] = r[13];
+    RES->bitsu64[6] = r[14];
+    RES->bitsu64[7] = r[15];
+    lvl5_fp_reduce(RES);
+}
+
+// RES = a * b * 2^-512 mod P, a, b < P
+static inline void lvl5_fp_mul(lvl5_fp_t *RES, const lvl5_fp_t *a, const lvl5_fp_t *b) {
+    unsigned __int128 t;
+    uint64_t q, c, t0 = 0, t1 = 0, t2 = 0, t3 = 0, t4 = 0, t5 = 0, t6 = 0, t7 = 0, t8 = 0, t9 = 0;
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[0] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[0] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[0] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[0] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[0] + t4 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[0] + t5 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[0] + t6 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[0] + t7 + c; t7 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t8 = (uint64_t)t; t9 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t4 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t5 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t6 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + t7 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t7 = (uint64_t)t; t8 = t9 + (uint64_t)(t >> 64);
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[1] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[1] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[1] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[1] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[1] + t4 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[1] + t5 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[1] + t6 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[1] + t7 + c; t7 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t8 = (uint64_t)t; t9 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t4 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t5 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t6 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + t7 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t7 = (uint64_t)t; t8 = t9 + (uint64_t)(t >> 64);
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[2] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[2] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[2] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[2] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[2] + t4 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[2] + t5 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[2] + t6 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[2] + t7 + c; t7 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t8 = (uint64_t)t; t9 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t4 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t5 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t6 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + t7 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t7 = (uint64_t)t; t8 = t9 + (uint64_t)(t >> 64);
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[3] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[3] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[3] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[3] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[3] + t4 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[3] + t5 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[3] + t6 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[3] + t7 + c; t7 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t8 = (uint64_t)t; t9 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t4 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t5 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t6 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + t7 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t7 = (uint64_t)t; t8 = t9 + (uint64_t)(t >> 64);
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[4] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[4] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[4] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[4] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[4] + t4 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[4] + t5 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[4] + t6 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[4] + t7 + c; t7 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t8 = (uint64_t)t; t9 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t4 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t5 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t6 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + t7 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t7 = (uint64_t)t; t8 = t9 + (uint64_t)(t >> 64);
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[5] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[5] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[5] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[5] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[5] + t4 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[5] + t5 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[5] + t6 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[5] + t7 + c; t7 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t8 = (uint64_t)t; t9 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t4 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t5 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t6 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + t7 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t7 = (uint64_t)t; t8 = t9 + (uint64_t)(t >> 64);
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[6] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[6] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[6] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[6] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[6] + t4 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[6] + t5 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[6] + t6 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[6] + t7 + c; t7 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t8 = (uint64_t)t; t9 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t4 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t5 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t6 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + t7 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t7 = (uint64_t)t; t8 = t9 + (uint64_t)(t >> 64);
+
+    t = (unsigned __int128)a->bitsu64[0] * b->bitsu64[7] + t0; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[1] * b->bitsu64[7] + t1 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[2] * b->bitsu64[7] + t2 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[3] * b->bitsu64[7] + t3 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[4] * b->bitsu64[7] + t4 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[5] * b->bitsu64[7] + t5 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[6] * b->bitsu64[7] + t6 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)a->bitsu64[7] * b->bitsu64[7] + t7 + c; t7 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t8 = (uint64_t)t; t9 = (uint64_t)(t >> 64);
+    q = t0;
+    t = ((unsigned __int128)q << 64) - q + t0; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t1 + c; t0 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t2 + c; t1 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t3 + c; t2 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t4 + c; t3 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t5 + c; t4 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = ((unsigned __int128)q << 64) - q + t6 + c; t5 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)q * LVL5_P.bitsu64[7] + t7 + c; t6 = (uint64_t)t; c = (uint64_t)(t >> 64);
+    t = (unsigned __int128)t8 + c; t7 = (uint64_t)t; t8 = t9 + (uint64_t)(t >> 64);
+
+    RES->bitsu64[0] = t0;
+    RES->bitsu64[1] = t1;
+    RES->bitsu64[2] = t2;
+    RES->bitsu64[3] = t3;
+    RES->bitsu64[4] = t4;
+    RES->bitsu64[5] = t5;
+    RES->bitsu64[6] = t6;
+    RES->bitsu64[7] = t7;
+    lvl5_fp_reduce(RES);
+}
+
+static inline void lvl5_fp_sqr(lvl5_fp_t *RES, const lvl5_fp_t *a) {
+    uint64_t r[16];
+
+    lvl5_fp_sqr_wide(r, a);
+    lvl5_fp_redc(RES, r);
+}
+
+static inline void lvl5_fp_to_mont(lvl5_fp_t *RES, const lvl5_fp_t *a) {
+    lvl5_fp_mul(RES, a, &LVL5_R2);
+}
+
+static inline void lvl5_fp_from_mont(lvl5_fp_t *RES, const lvl5_fp_t *a) {
+    uint64_t r[16] = { 0 };
+
+    r[0] = a->bitsu64[0];
+    r[1] = a->bitsu64[1];
+    r[2] = a->bitsu64[2];
+    r[3] = a->bitsu64[3];
+    r[4] = a->bitsu64[4];
+    r[5] = a->bitsu64[5];
+    r[6] = a->bitsu64[6];
+    r[7] = a->bitsu64[7];
+    lvl5_fp_redc(RES, r);
+}
+
+// a^(P-2), Montgomery form in and out; 0 maps to 0. The exponent is
+// public, so the 4-bit window digits drive the loop directly.
+static inline void lvl5_fp_inv(lvl5_fp_t *RES, const lvl5_fp_t *a) {
+    lvl5_fp_t tab[16];
+    lvl5_fp_t x;
+
+    tab[0] = LVL5_R1;
+    tab[1] = *a;
+    for (int i = 2; i < 16; i++)
+        lvl5_fp_mul(&tab[i], &tab[i - 1], a);
+
+    x = tab[LVL5_INV_DIGITS[0]];
+    for (int i = 1; i < 127; i++) {
+        lvl5_fp_sqr(&x, &x);
+        lvl5_fp_sqr(&x, &x);
+        lvl5_fp_sqr(&x, &x);
+        lvl5_fp_sqr(&x, &x);
+        if (LVL5_INV_DIGITS[i])
+            lvl5_fp_mul(&x, &x, &tab[LVL5_INV_DIGITS[i]]);
+    }
+    *RES = x;
+}
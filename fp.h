@@ -6,22 +6,115 @@
 #include <stdint.h>
 #include <string.h>
 #include <sys/endian.h>
+#ifdef FP_DEBUG_BOUNDS
+#include <assert.h>
+#endif
+
+/* Field elements live in Montgomery form x*2^256 mod P for their whole
+ * life. Conversion happens only at the edges: fp2_pack/fp2_unpack (and so
+ * hashing) and constant loading through fp_to_mont/fp_set_u64.
+ *
+ * Lazy reduction: inside a formula an element is any integer below k*P,
+ * with its bound k tracked in multiples of P. fp_add never reduces,
+ * fp_sub adds a multiple of P large enough to stay non-negative, and the
+ * multiplier takes inputs below FP_BOUND_MUL*P and returns [0, P).
+ * Elements stored in structs (theta points, quaternions) are reduced.
+ * Every formula checks its budget with _Static_assert on the FP_BOUND_*
+ * macros; building with -DFP_DEBUG_BOUNDS also asserts them at runtime. */
+
+#define FP_BOUND_MUL 32           // 32P < 2^256, the multiplier input limit
+#define FP_SUB_PAD 4              // fp_sub: subtrahend < 4P
+#define FP_SUB_WIDE_PAD 16        // fp_sub_wide: subtrahend < 16P
+
+#define FP_BOUND_ADD(x, y) ((x) + (y))
+#define FP_BOUND_SUB(x) ((x) + FP_SUB_PAD)
+#define FP_BOUND_SUB_WIDE(x) ((x) + FP_SUB_WIDE_PAD)
+
+#ifdef FP_DEBUG_BOUNDS
+static inline bool fp_within_bound(const oriint_t *a, uint64_t k) {
+    oriint_t kp;
+    oriint_t t;
+
+    oriint_mult(&kp, &P, k);
+    oriint_sub_3(&t, a, &kp);
+    return (a->bits64[NBLOCK - 1] >= 0) && (t.bits64[NBLOCK - 1] < 0);
+}
+#define FP_ASSERT_BOUND(a, k) assert(fp_within_bound((a), (k)))
+#define FP_ASSERT_SMALL(s, bits) assert((s) > -((int64_t)1 << (bits)) && (s) < ((int64_t)1 << (bits)))
+#else
+#define FP_ASSERT_BOUND(a, k) ((void)0)
+#define FP_ASSERT_SMALL(s, bits) ((void)0)
+#endif
 
 static inline void fp_add(oriint_t *RES, oriint_t *a, oriint_t *b) {
     oriint_add_3(RES, a, b);
+    FP_ASSERT_BOUND(RES, FP_BOUND_MUL);
 }
 
 static inline void fp_sub(oriint_t *RES, oriint_t *a, oriint_t *b) {
+    FP_ASSERT_BOUND(b, FP_SUB_PAD);
     oriint_sub_3(RES, a, b);
+    oriint_add_1(RES, &P4);
+}
+
+static inline void fp_sub_wide(oriint_t *RES, oriint_t *a, oriint_t *b) {
+    FP_ASSERT_BOUND(b, FP_SUB_WIDE_PAD);
+    oriint_sub_3(RES, a, b);
+    oriint_add_1(RES, &P16);
+}
+
+// Any lazy element to [0, P)
+static inline void fp_reduce(oriint_t *RES) {
+    oriint_fold_p(RES);
 }
 
 static inline void fp_mul(oriint_t *RES, oriint_t *a, oriint_t *b) {
-    oriint_set(RES, a);
-    oriint_modmul(RES, b);
+    FP_ASSERT_BOUND(a, FP_BOUND_MUL);
+    FP_ASSERT_BOUND(b, FP_BOUND_MUL);
+    oriint_montmul(RES, a, b);
+}
+
+static inline void fp_sqr(oriint_t *RES, oriint_t *a) {
+    FP_ASSERT_BOUND(a, FP_BOUND_MUL);
+    oriint_montsqr(RES, a);
+}
+
+static inline void fp_to_mont(oriint_t *RES, const oriint_t *a) {
+    oriint_montmul(RES, a, &R2);
 }
 
+static inline void fp_from_mont(oriint_t *RES, const oriint_t *a) {
+    uint64_t r512[8] = { a->bitsu64[0], a->bitsu64[1], a->bitsu64[2], a->bitsu64[3], 0, 0, 0, 0 };
+    oriint_redc_512(RES, r512);
+}
+
+static inline void fp_set_u64(oriint_t *RES, uint64_t a) {
+    oriint_t t;
+    oriint_clear(&t);
+    t.bitsu64[0] = a;
+    fp_to_mont(RES, &t);
+}
+
+// (aR)^-1 = a^-1 R^-1, one multiply by R^3 brings it back to a^-1 R
 static inline void fp_inv(oriint_t *RES) {
     oriint_modinv(RES);
+    oriint_montmul(RES, RES, &R3);
+}
+
+// fp_inv for public inputs only
+static inline void fp_inv_vartime(oriint_t *RES) {
+    oriint_modinv_vartime(RES);
+    oriint_montmul(RES, RES, &R3);
+}
+
+// Legendre symbol of a (in Montgomery form). R = (2^128)^2 is a square,
+// so (aR / P) = (a / P).
+static inline int fp_legendre(oriint_t *a) {
+    return oriint_legendre(a);
+}
+
+static inline int fp_legendre_vartime(oriint_t *a) {
+    return oriint_legendre_vartime(a);
 }
 
 static inline void fp2_add(fp2_t *RES, fp2_t *a, fp2_t *b) {
@@ -34,27 +127,109 @@ static inline void fp2_sub(fp2_t *RES, fp2_t *a, fp2_t *b) {
     fp_sub(&RES->im, &a->im, &b->im);
 }
 
+static inline void fp2_sub_wide(fp2_t *RES, fp2_t *a, fp2_t *b) {
+    fp_sub_wide(&RES->re, &a->re, &b->re);
+    fp_sub_wide(&RES->im, &a->im, &b->im);
+}
+
+static inline void fp2_reduce(fp2_t *RES) {
+    fp_reduce(&RES->re);
+    fp_reduce(&RES->im);
+}
+
+// Karatsuba: re = ac - bd, im = (a + b)(c + d) - ac - bd. The three
+// products stay double width and each coordinate takes one REDC; re is
+// padded with 16P * 2^256 > bd so it never goes negative.
+// Inputs < 16P (the sums must stay below FP_BOUND_MUL); output < P.
 static inline void fp2_mul(fp2_t *RES, fp2_t *a, fp2_t *b) {
-    oriint_t ac;
-    oriint_t bd;
-    oriint_t t1;
-    oriint_t t2;
-    oriint_t ad_bc0;
-    oriint_t ad_bc1;
+    uint64_t ac[8];
+    uint64_t bd[8];
+    uint64_t im[8];
+    oriint_t sa;
+    oriint_t sb;
+
+    // (16P)^2 <= 16P * 2^256 and (32P)^2 + 16P * 2^256 < 2^512
+    _Static_assert(FP_BOUND_ADD(16, 16) <= FP_BOUND_MUL, "fp2_mul bound");
+    FP_ASSERT_BOUND(&a->re, 16);
+    FP_ASSERT_BOUND(&a->im, 16);
+    FP_ASSERT_BOUND(&b->re, 16);
+    FP_ASSERT_BOUND(&b->im, 16);
+
+    fp_add(&sa, &a->re, &a->im);
+    fp_add(&sb, &b->re, &b->im);
+    oriint_mul_512(ac, a->re.bitsu64, b->re.bitsu64);
+    oriint_mul_512(bd, a->im.bitsu64, b->im.bitsu64);
+    oriint_mul_512(im, sa.bitsu64, sb.bitsu64);
+
+    oriint_sub_512(im, ac);
+    oriint_sub_512(im, bd);
+    oriint_redc_512(&RES->im, im);
+
+    oriint_sub_512(ac, bd);
+    oriint_add_512_hi(ac, &P16);
+    oriint_redc_512(&RES->re, ac);
+}
+
+// RES = sum over i < n <= 4 of a[i] * b[i], term i negated when bit i of
+// neg is set. The products are accumulated double width, padded with
+// 4P * 2^256 >= 4P^2 so the sum stays non-negative, and reduced by one REDC.
+// Inputs < P (reduced, as stored in structs); output < P.
+static inline void fp_mul_sum(oriint_t *RES, oriint_t *const *a, oriint_t *const *b, int n, unsigned neg) {
+    uint64_t acc[8] = { 0 };
+    uint64_t t[8];
+
+    for (int i = 0; i < n; i++) {
+        FP_ASSERT_BOUND(a[i], 1);
+        FP_ASSERT_BOUND(b[i], 1);
+        oriint_mul_512(t, a[i]->bitsu64, b[i]->bitsu64);
+        if ((neg >> i) & 1)
+            oriint_sub_512(acc, t);
+        else
+            oriint_add_512(acc, t);
+    }
+    oriint_add_512_hi(acc, &P4);
+    oriint_redc_512(RES, acc);
+}
+
+// fp_mul_sum on both coordinates of a[i] with Fp scalars b[i]
+static inline void fp2_mul_sum(fp2_t *RES, fp2_t *const *a, oriint_t *const *b, int n, unsigned neg) {
+    oriint_t *re[4];
+    oriint_t *im[4];
+
+    for (int i = 0; i < n; i++) {
+        re[i] = &a[i]->re;
+        im[i] = &a[i]->im;
+    }
+    fp_mul_sum(&RES->re, re, b, n, neg);
+    fp_mul_sum(&RES->im, im, b, n, neg);
+}
 
-    fp_mul(&ac, &a->re, &b->re);
-    fp_mul(&bd, &a->im, &b->im);
-    fp_mul(&t1, &a->re, &a->im);
-    fp_mul(&t2, &b->re, &b->im);
+// (a + bi)^2 = (a + b)(a - b) + 2ab i. Both products stay double width,
+// ab is doubled there and each coordinate takes one REDC, as in fp2_mul.
+// Inputs < 16P; output < P.
+static inline void fp2_sqr(fp2_t *RES, fp2_t *a) {
+    uint64_t re[8];
+    uint64_t im[8];
+    oriint_t apb;
+    oriint_t amb;
 
-    fp_sub(&RES->re, &ac, &bd);
+    // (32P)^2 and 2 * (16P)^2 < 2^512
+    _Static_assert(FP_BOUND_ADD(16, 16) <= FP_BOUND_MUL, "fp2_sqr bound");
+    _Static_assert(FP_BOUND_SUB_WIDE(16) <= FP_BOUND_MUL, "fp2_sqr bound");
+    FP_ASSERT_BOUND(&a->re, 16);
+    FP_ASSERT_BOUND(&a->im, 16);
 
-    fp_mul(&ad_bc0, &t1, &t2);
-    fp_sub(&ad_bc1, &ad_bc0, &ac);
+    fp_add(&apb, &a->re, &a->im);
+    fp_sub_wide(&amb, &a->re, &a->im);
+    oriint_mul_512(re, apb.bitsu64, amb.bitsu64);
+    oriint_mul_512(im, a->re.bitsu64, a->im.bitsu64);
+    oriint_add_512(im, im);
 
-    fp_sub(&RES->im, &ad_bc1, &bd);
+    oriint_redc_512(&RES->re, re);
+    oriint_redc_512(&RES->im, im);
 }
 
+// 0 - im0 is 4P when im0 is 0, so im is reduced as well. Output < P.
 static inline void fp2_inv(fp2_t *RES, fp2_t *a) {
     oriint_t a2;
     oriint_t b2;
@@ -63,8 +238,8 @@ static inline void fp2_inv(fp2_t *RES, fp2_t *a) {
     oriint_t zero;
     
     oriint_clear(&zero);
-    fp_mul(&a2, &a->re, &a->re);
-    fp_mul(&b2, &a->im, &a->im);
+    fp_sqr(&a2, &a->re);
+    fp_sqr(&b2, &a->im);
     fp_add(&norm, &a2, &b2);
     fp_inv(&norm);
 
@@ -73,25 +248,76 @@ static inline void fp2_inv(fp2_t *RES, fp2_t *a) {
     fp_mul(&im0, &a->im, &norm);
 
     fp_sub(&RES->im, &zero, &im0);
+    fp_reduce(&RES->im);
+}
+
+// fp2_inv for public inputs only (verification, decompression)
+static inline void fp2_inv_vartime(fp2_t *RES, fp2_t *a) {
+    oriint_t a2;
+    oriint_t b2;
+    oriint_t norm;
+    oriint_t im0;
+    oriint_t zero;
+
+    oriint_clear(&zero);
+    fp_sqr(&a2, &a->re);
+    fp_sqr(&b2, &a->im);
+    fp_add(&norm, &a2, &b2);
+    fp_inv_vartime(&norm);
+
+    fp_mul(&RES->re, &a->re, &norm);
+
+    fp_mul(&im0, &a->im, &norm);
+
+    fp_sub(&RES->im, &zero, &im0);
+    fp_reduce(&RES->im);
+}
+
+static inline void fp2_set(fp2_t *RES, fp2_t *a) {
+    oriint_set(&RES->re, &a->re);
+    oriint_set(&RES->im, &a->im);
 }
 
 static inline bool fp2_is_zero(fp2_t *a) {
-    return (oriint_is_zero(&a->re) & oriint_is_zero(&a->im));
+    fp2_t t;
+    fp2_set(&t, a);
+    fp2_reduce(&t);
+    return (oriint_is_zero(&t.re) & oriint_is_zero(&t.im));
+}
+
+// fp2_is_zero for inputs < 2P without the reduction: a coordinate below
+// 2P is zero mod P iff it is 0 or P.
+static inline bool fp2_is_zero_2p(fp2_t *a) {
+    FP_ASSERT_BOUND(&a->re, 2);
+    FP_ASSERT_BOUND(&a->im, 2);
+    return ((oriint_is_zero(&a->re) | oriint_is_equal(&a->re, &P)) &
+            (oriint_is_zero(&a->im) | oriint_is_equal(&a->im, &P)));
 }
 
 static inline bool fp2_equal(fp2_t *a, fp2_t *b) {
-    return (oriint_is_equal(&a->re, &b->re) & oriint_is_equal(&a->im, &b->im));
+    fp2_t s;
+    fp2_t t;
+    fp2_set(&s, a);
+    fp2_set(&t, b);
+    fp2_reduce(&s);
+    fp2_reduce(&t);
+    return (oriint_is_equal(&s.re, &t.re) & oriint_is_equal(&s.im, &t.im));
 }
 
 static inline void fp2_pack(uint8_t out[2 * FP_BYTES], fp2_t *a) {
+    oriint_t re;
+    oriint_t im;
     size_t offset = 0;
+
+    fp_from_mont(&re, &a->re);
+    fp_from_mont(&im, &a->im);
     for (size_t i = 0; i < NBLOCK; i++) {
-        uint64_t v_be = htobe64(a->re.bitsu64[i]);
+        uint64_t v_be = htobe64(re.bitsu64[i]);
         memcpy(out + offset, &v_be, sizeof(uint64_t));
         offset += sizeof(uint64_t);
     }
     for (size_t i = 0; i < NBLOCK; i++) {
-        uint64_t v_be = htobe64(a->im.bitsu64[i]);
+        uint64_t v_be = htobe64(im.bitsu64[i]);
         memcpy(out + offset, &v_be, sizeof(uint64_t));
         offset += sizeof(uint64_t);
     }
@@ -111,6 +337,35 @@ static inline void fp2_unpack(fp2_t *RES, const uint8_t in[2 * FP_BYTES]) {
         RES->im.bitsu64[i] = be64toh(v_be);
         offset += sizeof(uint64_t);
     }
+    fp_to_mont(&RES->re, &RES->re);
+    fp_to_mont(&RES->im, &RES->im);
+}
+
+// Storage form (fp_packed_t): reduced, top limb dropped
+static inline void fp_store(fp_packed_t *RES, const oriint_t *a) {
+    oriint_t t;
+
+    oriint_set(&t, a);
+    fp_reduce(&t);
+    for (int i = 0; i < NBLOCK_PACKED; i++)
+        RES->bitsu64[i] = t.bitsu64[i];
+}
+
+static inline void fp_load(oriint_t *RES, const fp_packed_t *a) {
+    for (int i = 0; i < NBLOCK_PACKED; i++)
+        RES->bitsu64[i] = a->bitsu64[i];
+    for (int i = NBLOCK_PACKED; i < NBLOCK; i++)
+        RES->bitsu64[i] = 0;
+}
+
+static inline void fp2_store(fp2_packed_t *RES, const fp2_t *a) {
+    fp_store(&RES->re, &a->re);
+    fp_store(&RES->im, &a->im);
+}
+
+static inline void fp2_load(fp2_t *RES, const fp2_packed_t *a) {
+    fp_load(&RES->re, &a->re);
+    fp_load(&RES->im, &a->im);
 }
 
 static inline void fp2_mul_scalar(fp2_t *RES, fp2_t *a, oriint_t *b) {
@@ -118,6 +373,29 @@ static inline void fp2_mul_scalar(fp2_t *RES, fp2_t *a, oriint_t *b) {
     fp_mul(&RES->im, &a->im, b);
 }
 
+// RES = s * a for a small signed integer s, |s| < 2^55: a is negated as
+// 16P - a when s < 0, multiplied by |s| in one limb row (oriint_imm_mul),
+// and folded once. No Montgomery factor is involved since s is a plain
+// integer. Branchless; input < 16P; output < P.
+static inline void fp_mul_small(oriint_t *RES, oriint_t *a, int64_t s) {
+    uint64_t mask = (uint64_t)(s >> 63);
+    uint64_t abs_s = ((uint64_t)s ^ mask) - mask;
+    oriint_t n;
+
+    // 16P * 2^55 < 2^312, the oriint_fold_p limit
+    FP_ASSERT_BOUND(a, FP_SUB_WIDE_PAD);
+    FP_ASSERT_SMALL(s, 55);
+    oriint_sub_3(&n, &P16, a);
+    oriint_select_mask(RES, a, &n, mask);
+    oriint_imm_mul(RES->bitsu64, abs_s, RES->bitsu64);
+    oriint_fold_p(RES);
+}
+
+static inline void fp2_mul_small(fp2_t *RES, fp2_t *a, int64_t s) {
+    fp_mul_small(&RES->re, &a->re, s);
+    fp_mul_small(&RES->im, &a->im, s);
+}
+
 static inline void fp2_cmov(fp2_t *RES, fp2_t *a, fp2_t *b, uint64_t mask) {
     oriint_select_mask(&RES->re, &a->re, &b->re, mask);
     oriint_select_mask(&RES->im, &a->im, &b->im, mask);
@@ -128,13 +406,314 @@ static inline void fp2_clear(fp2_t *RES) {
     oriint_clear(&RES->im);
 }
 
-static inline void fp2_set(fp2_t *RES, fp2_t *a) {
-    oriint_set(&RES->re, &a->re);
-    oriint_set(&RES->im, &a->im);
-}
-
 static inline void fp2_set_one(fp2_t *RES) {
-    oriint_set_one(&RES->re);
+    oriint_set(&RES->re, &R1);
     oriint_clear(&RES->im);
 }
 
+
+// a + bi is a square in Fp2 iff its norm a^2 + b^2 is a square in Fp
+static inline bool fp2_is_square(fp2_t *a) {
+    oriint_t a2;
+    oriint_t b2;
+    oriint_t norm;
+
+    fp_sqr(&a2, &a->re);
+    fp_sqr(&b2, &a->im);
+    fp_add(&norm, &a2, &b2);
+    return fp_legendre(&norm) != -1;
+}
+
+static inline bool fp2_is_square_vartime(fp2_t *a) {
+    oriint_t a2;
+    oriint_t b2;
+    oriint_t norm;
+
+    fp_sqr(&a2, &a->re);
+    fp_sqr(&b2, &a->im);
+    fp_add(&norm, &a2, &b2);
+    return fp_legendre_vartime(&norm) != -1;
+}
+
+// All-ones if a == 0 mod P, else 0. Constant time.
+static inline uint64_t fp_zero_mask(const oriint_t *a) {
+    oriint_t t;
+    uint64_t acc = 0;
+    oriint_set(&t, a);
+    fp_reduce(&t);
+    for (int i = 0; i < NBLOCK; i++)
+        acc |= t.bitsu64[i];
+    return ((acc | (0 - acc)) >> 63) - 1;
+}
+
+// RES[i * s] = a[i * s]^-1 for i < n with one fp_inv and 3(n-1)
+// multiplications (Montgomery's trick). Zero inputs map to zero; they are
+// swapped for one in the running product so neither the timing nor the
+// other outputs depend on which inputs were zero. The stride s lets
+// fp2_inv_batch run on the coordinates of an fp2_t array. RES and a must
+// not overlap. Outputs < P.
+static inline void fp_inv_batch_stride(oriint_t *RES, oriint_t *a, size_t n, size_t s) {
+    oriint_t acc;
+    oriint_t inv;
+    oriint_t x;
+    oriint_t t;
+    oriint_t one;
+    oriint_t zero;
+    uint64_t z;
+
+    if (n == 0)
+        return;
+
+    oriint_set(&one, &R1);
+    oriint_clear(&zero);
+
+    // RES[i] = a[0] * ... * a[i - 1] for i > 0
+    oriint_set(&acc, &a[0]);
+    oriint_select_mask(&acc, &acc, &one, fp_zero_mask(&a[0]));
+    for (size_t i = 1; i < n; i++) {
+        oriint_set(&x, &a[i * s]);
+        oriint_select_mask(&x, &x, &one, fp_zero_mask(&a[i * s]));
+        oriint_set(&RES[i * s], &acc);
+        fp_mul(&acc, &acc, &x);
+    }
+
+    oriint_set(&inv, &acc);
+    fp_inv(&inv);
+
+    // inv = (a[0] * ... * a[i])^-1 on entry to step i
+    for (size_t i = n - 1; i > 0; i--) {
+        z = fp_zero_mask(&a[i * s]);
+        oriint_set(&x, &a[i * s]);
+        oriint_select_mask(&x, &x, &one, z);
+        fp_mul(&t, &inv, &RES[i * s]);
+        fp_mul(&inv, &inv, &x);
+        oriint_select_mask(&RES[i * s], &t, &zero, z);
+    }
+    oriint_select_mask(&RES[0], &inv, &zero, fp_zero_mask(&a[0]));
+}
+
+static inline void fp_inv_batch(oriint_t *RES, oriint_t *a, size_t n) {
+    fp_inv_batch_stride(RES, a, n, 1);
+}
+
+// Batched fp2_inv: conj(a) / norm(a), the norms inverted by one
+// fp_inv_batch_stride from the re slots of RES into the im slots. A zero
+// input has a zero norm and so a zero output. RES and a must not overlap.
+// Output < P.
+static inline void fp2_inv_batch(fp2_t *RES, fp2_t *a, size_t n) {
+    oriint_t a2;
+    oriint_t b2;
+    oriint_t t;
+    oriint_t im0;
+    oriint_t zero;
+
+    _Static_assert(sizeof(fp2_t) == 2 * sizeof(oriint_t), "fp2_inv_batch: re and im interleave");
+
+    if (n == 0)
+        return;
+
+    oriint_clear(&zero);
+    for (size_t i = 0; i < n; i++) {
+        fp_sqr(&a2, &a[i].re);
+        fp_sqr(&b2, &a[i].im);
+        fp_add(&RES[i].re, &a2, &b2);
+    }
+
+    fp_inv_batch_stride(&RES[0].im, &RES[0].re, n, 2);
+
+    for (size_t i = 0; i < n; i++) {
+        oriint_set(&t, &RES[i].im);
+        fp_mul(&RES[i].re, &a[i].re, &t);
+        fp_mul(&im0, &a[i].im, &t);
+        fp_sub(&RES[i].im, &zero, &im0);
+        fp_reduce(&RES[i].im);
+    }
+}
+
+// a / 2: add P when odd, then shift. Input < 2^255; output < P for a < P.
+static inline void fp_half(oriint_t *RES, oriint_t *a) {
+    uint64_t mask = 0 - (a->bitsu64[0] & 1);
+    oriint_t t;
+
+    for (int i = 0; i < NBLOCK; i++)
+        t.bitsu64[i] = P.bitsu64[i] & mask;
+    oriint_add_3(RES, a, &t);
+    oriint_shiftr(1, RES);
+}
+
+static inline void fp_sqr_n(oriint_t *RES, int n) {
+    for (int i = 0; i < n; i++)
+        fp_sqr(RES, RES);
+}
+
+// RES = a^((P-3)/4) = a^(5*(2^246 - 1) + 4), x_k below being a^(2^k - 1):
+// 248 squarings, 12 multiplies. One more multiply by a gives the square
+// root candidate a^((P+1)/4), and z * a * z = a^((P-1)/2) the Legendre
+// symbol, so both share this chain. Output < P.
+static inline void fp_pow_p34(oriint_t *RES, oriint_t *a) {
+    oriint_t a2, a4, x2, x3, x6, x12, x24, x48, x96, x192, x240, x246;
+
+    fp_sqr(&a2, a);
+    fp_mul(&x2, &a2, a);
+    fp_sqr(&x3, &x2);
+    fp_mul(&x3, &x3, a);
+    oriint_set(&x6, &x3);
+    fp_sqr_n(&x6, 3);
+    fp_mul(&x6, &x6, &x3);
+    oriint_set(&x12, &x6);
+    fp_sqr_n(&x12, 6);
+    fp_mul(&x12, &x12, &x6);
+    oriint_set(&x24, &x12);
+    fp_sqr_n(&x24, 12);
+    fp_mul(&x24, &x24, &x12);
+    oriint_set(&x48, &x24);
+    fp_sqr_n(&x48, 24);
+    fp_mul(&x48, &x48, &x24);
+    oriint_set(&x96, &x48);
+    fp_sqr_n(&x96, 48);
+    fp_mul(&x96, &x96, &x48);
+    oriint_set(&x192, &x96);
+    fp_sqr_n(&x192, 96);
+    fp_mul(&x192, &x192, &x96);
+    oriint_set(&x240, &x192);
+    fp_sqr_n(&x240, 48);
+    fp_mul(&x240, &x240, &x48);
+    oriint_set(&x246, &x240);
+    fp_sqr_n(&x246, 6);
+    fp_mul(&x246, &x246, &x6);
+
+    // x246^5 * a^4
+    fp_sqr(&a4, &a2);
+    oriint_set(RES, &x246);
+    fp_sqr_n(RES, 2);
+    fp_mul(RES, RES, &x246);
+    fp_mul(RES, RES, &a4);
+}
+
+// RES = a^((P+1)/4), a square root of a when one exists. Returns whether
+// RES^2 == a. Constant time; output < P.
+static inline bool fp_sqrt(oriint_t *RES, oriint_t *a) {
+    oriint_t z;
+    oriint_t r;
+    oriint_t ra;
+
+    oriint_set(&ra, a);
+    fp_reduce(&ra);
+    fp_pow_p34(&z, &ra);
+    fp_mul(RES, &z, &ra);
+    fp_sqr(&r, RES);
+    return oriint_is_equal(&r, &ra);
+}
+
+// Square root in Fp2 = Fp(i), i^2 = -1, for P = 3 mod 4, with two calls to
+// fp_pow_p34. For a = x + yi write n = x^2 + y^2, s = sqrt(n), t = (x + s)/2
+// (t = (x - s)/2 if that is zero, which only happens for y = 0), z = t^((P-3)/4),
+// r = z t and chi = r z = (t / P). Then 1/r = chi z and
+//   chi = 1:  sqrt(a) = r + (y z / 2) i         (r^2 = t)
+//   chi = -1: sqrt(a) = -(y z / 2) + r i        (r^2 = -t)
+// Returns whether a is a square (RES^2 == a); RES is meaningless otherwise.
+// Constant time. Inputs < 16P; output < P.
+static inline bool fp2_sqrt(fp2_t *RES, fp2_t *a) {
+    oriint_t x, y, n, s, t, t1, z, r, chi, w, nw, u, v;
+    fp2_t c;
+    uint64_t sq;
+
+    _Static_assert(FP_BOUND_SUB(1) <= FP_BOUND_MUL, "fp2_sqrt bound");
+
+    oriint_set(&x, &a->re);
+    oriint_set(&y, &a->im);
+    fp_reduce(&x);
+    fp_reduce(&y);
+
+    // s = n^((P+1)/4)
+    fp_sqr(&n, &x);
+    fp_sqr(&t, &y);
+    fp_add(&n, &n, &t);
+    fp_reduce(&n);
+    fp_pow_p34(&s, &n);
+    fp_mul(&s, &s, &n);
+
+    fp_add(&t, &x, &s);
+    fp_reduce(&t);
+    fp_half(&t, &t);
+    fp_sub(&t1, &x, &s);
+    fp_reduce(&t1);
+    fp_half(&t1, &t1);
+    oriint_select_mask(&t, &t, &t1, fp_zero_mask(&t));
+
+    fp_pow_p34(&z, &t);
+    fp_mul(&r, &z, &t);
+    fp_mul(&chi, &r, &z);
+    sq = 0 - (uint64_t)oriint_is_equal(&chi, &R1);
+
+    fp_mul(&w, &y, &z);
+    fp_half(&w, &w);
+    oriint_clear(&nw);
+    fp_sub(&nw, &nw, &w);
+    fp_reduce(&nw);
+
+    oriint_select_mask(&u, &nw, &r, sq);
+    oriint_select_mask(&v, &r, &w, sq);
+    oriint_set(&RES->re, &u);
+    oriint_set(&RES->im, &v);
+
+    fp2_sqr(&c, RES);
+    return fp2_equal(&c, a);
+}
+
+// fp2_sqrt for public inputs only. a is a square iff its norm n is, and
+// the norm chain gives that for free: with zn = n^((P-3)/4), s = zn n and
+// s zn = (n / P), so a non-square is rejected after one fp_pow_p34 and a
+// square needs no final check. y = 0 takes one Fp root.
+static inline bool fp2_sqrt_vartime(fp2_t *RES, fp2_t *a) {
+    oriint_t x, y, n, s, t, z, zn, r, chi, w;
+
+    oriint_set(&x, &a->re);
+    oriint_set(&y, &a->im);
+    fp_reduce(&x);
+    fp_reduce(&y);
+
+    if (oriint_is_zero(&y)) {
+        // x or -x is a square since -1 is not
+        oriint_clear(&RES->im);
+        if (fp_sqrt(&RES->re, &x))
+            return true;
+        oriint_clear(&t);
+        fp_sub(&t, &t, &x);
+        fp_reduce(&t);
+        fp_sqrt(&RES->im, &t);
+        oriint_clear(&RES->re);
+        return true;
+    }
+
+    fp_sqr(&n, &x);
+    fp_sqr(&t, &y);
+    fp_add(&n, &n, &t);
+    fp_reduce(&n);
+    fp_pow_p34(&zn, &n);
+    fp_mul(&s, &zn, &n);
+    fp_mul(&chi, &s, &zn);
+    if (!oriint_is_equal(&chi, &R1))
+        return false;
+
+    // y != 0, so t != 0
+    fp_add(&t, &x, &s);
+    fp_reduce(&t);
+    fp_half(&t, &t);
+    fp_pow_p34(&z, &t);
+    fp_mul(&r, &z, &t);
+    fp_mul(&chi, &r, &z);
+
+    fp_mul(&w, &y, &z);
+    fp_half(&w, &w);
+    if (oriint_is_equal(&chi, &R1)) {
+        oriint_set(&RES->re, &r);
+        oriint_set(&RES->im, &w);
+    } else {
+        oriint_clear(&RES->re);
+        fp_sub(&RES->re, &RES->re, &w);
+        fp_reduce(&RES->re);
+        oriint_set(&RES->im, &r);
+    }
+    return true;
+}
@@ -0,0 +1,239 @@
+#pragma once
+#include "constants.h"
+#include "fp.h"
+#include "globals.h"
+#include "int.h"
+#include "types.h"
+#include <stdint.h>
+
+#ifndef ORIINT_PORTABLE
+#include <immintrin.h>
+
+/* Four-lane Fp backend on AVX-512 IFMA (VL, 256-bit vectors). One fp4_t
+ * holds four independent field elements, lane k of limb i being bits
+ * [52i, 52i + 52) of element k.
+ *
+ * Montgomery radix is 2^260 here against 2^256 in fp.h, so fp4_load
+ * multiplies by 16 (x*2^256 -> x*2^260) and fp4_store divides by 16
+ * (cheap since P = -1 mod 16). Products stay in the 2^260 domain.
+ *
+ * Bounds are tracked in multiples of P as in fp.h, with more room: limbs
+ * are normalized (< 2^52) after every operation since madd52 reads only the
+ * low 52 bits, so any value below 2^260 > 800P is representable. fp4_mul
+ * returns below (a*b/819 + 1)P for inputs below aP and bP; fp4_sub pads
+ * with 32P and fp4_sub_wide with 128P, bounding their subtrahends.
+ *
+ * Used only when oriint_cpu_ifma is set; callers keep the scalar path.
+ * Compiled out under ORIINT_PORTABLE. */
+
+#define FP4_TARGET __attribute__((target("avx2,avx512f,avx512vl,avx512ifma")))
+#define FP4_MASK52 0x000fffffffffffffULL
+
+typedef struct { __m256i l[NBLOCK]; } fp4_t;
+
+// Carry every limb into the next (signed limbs allowed); the value must be
+// in [0, 2^260)
+FP4_TARGET static inline void fp4_normalize(fp4_t *RES) {
+    const __m256i m = _mm256_set1_epi64x(FP4_MASK52);
+    #pragma GCC unroll 5
+    for (int i = 0; i < NBLOCK - 1; i++) {
+        __m256i c = _mm256_srai_epi64(RES->l[i], 52);
+        RES->l[i] = _mm256_and_si256(RES->l[i], m);
+        RES->l[i + 1] = _mm256_add_epi64(RES->l[i + 1], c);
+    }
+}
+
+FP4_TARGET static inline void fp4_add(fp4_t *RES, const fp4_t *a, const fp4_t *b) {
+    for (int i = 0; i < NBLOCK; i++)
+        RES->l[i] = _mm256_add_epi64(a->l[i], b->l[i]);
+    fp4_normalize(RES);
+}
+
+// a + 32P - b, b < 32P
+FP4_TARGET static inline void fp4_sub(fp4_t *RES, const fp4_t *a, const fp4_t *b) {
+    for (int i = 0; i < NBLOCK; i++)
+        RES->l[i] = _mm256_sub_epi64(_mm256_add_epi64(a->l[i], _mm256_set1_epi64x(P32_R52[i])), b->l[i]);
+    fp4_normalize(RES);
+}
+
+// a + 128P - b, b < 128P
+FP4_TARGET static inline void fp4_sub_wide(fp4_t *RES, const fp4_t *a, const fp4_t *b) {
+    for (int i = 0; i < NBLOCK; i++)
+        RES->l[i] = _mm256_sub_epi64(_mm256_add_epi64(a->l[i], _mm256_set1_epi64x(P128_R52[i])), b->l[i]);
+    fp4_normalize(RES);
+}
+
+// RES = a * b * 2^-260 mod P, lane-wise. -P^-1 = 1 mod 2^52, so the
+// Montgomery quotient digit is just the low limb.
+FP4_TARGET static inline void fp4_mul(fp4_t *RES, const fp4_t *a, const fp4_t *b) {
+    const __m256i m = _mm256_set1_epi64x(FP4_MASK52);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i t[NBLOCK + 1];
+    __m256i p[NBLOCK];
+
+    for (int j = 0; j < NBLOCK; j++)
+        p[j] = _mm256_set1_epi64x(P_R52[j]);
+    for (int j = 0; j <= NBLOCK; j++)
+        t[j] = zero;
+
+    // Fully unrolled so t[] stays in registers
+    #pragma GCC unroll 5
+    for (int i = 0; i < NBLOCK; i++) {
+        __m256i bi = b->l[i];
+        __m256i q;
+
+        #pragma GCC unroll 5
+        for (int j = 0; j < NBLOCK; j++) {
+            t[j] = _mm256_madd52lo_epu64(t[j], a->l[j], bi);
+            t[j + 1] = _mm256_madd52hi_epu64(t[j + 1], a->l[j], bi);
+        }
+
+        q = _mm256_and_si256(t[0], m);
+        #pragma GCC unroll 5
+        for (int j = 0; j < NBLOCK; j++) {
+            t[j] = _mm256_madd52lo_epu64(t[j], q, p[j]);
+            t[j + 1] = _mm256_madd52hi_epu64(t[j + 1], q, p[j]);
+        }
+
+        // t[0] = 0 mod 2^52: shift one limb down
+        t[1] = _mm256_add_epi64(t[1], _mm256_srli_epi64(t[0], 52));
+        #pragma GCC unroll 5
+        for (int j = 0; j < NBLOCK; j++)
+            t[j] = t[j + 1];
+        t[NBLOCK] = zero;
+    }
+
+    #pragma GCC unroll 5
+    for (int j = 0; j < NBLOCK; j++)
+        RES->l[j] = t[j];
+    fp4_normalize(RES);
+}
+
+// Lane k of RES = lane idx[k] of a (imm as for _mm256_permute4x64_epi64)
+#define FP4_PERMUTE(RES, a, imm) \
+    do { \
+        for (int i_ = 0; i_ < NBLOCK; i_++) \
+            (RES)->l[i_] = _mm256_permute4x64_epi64((a)->l[i_], (imm)); \
+    } while (0)
+
+// Lanes 1 and 3 from b, lanes 0 and 2 from a
+FP4_TARGET static inline void fp4_blend_odd(fp4_t *RES, const fp4_t *a, const fp4_t *b) {
+    for (int i = 0; i < NBLOCK; i++)
+        RES->l[i] = _mm256_blend_epi32(a->l[i], b->l[i], 0xcc);
+}
+
+// Lane k = 16 * x[k] in radix 2^52; x[k] < 2^251 (reduced fp.h element)
+FP4_TARGET static inline void fp4_load(fp4_t *RES, const oriint_t *x0, const oriint_t *x1, const oriint_t *x2, const oriint_t *x3) {
+    const oriint_t *x[4] = { x0, x1, x2, x3 };
+    uint64_t l[NBLOCK][4] __attribute__((aligned(32)));
+
+    for (int k = 0; k < 4; k++) {
+        uint64_t a0 = x[k]->bitsu64[0] << 4;
+        uint64_t a1 = (x[k]->bitsu64[1] << 4) | (x[k]->bitsu64[0] >> 60);
+        uint64_t a2 = (x[k]->bitsu64[2] << 4) | (x[k]->bitsu64[1] >> 60);
+        uint64_t a3 = (x[k]->bitsu64[3] << 4) | (x[k]->bitsu64[2] >> 60);
+
+        l[0][k] = a0 & FP4_MASK52;
+        l[1][k] = ((a0 >> 52) | (a1 << 12)) & FP4_MASK52;
+        l[2][k] = ((a1 >> 40) | (a2 << 24)) & FP4_MASK52;
+        l[3][k] = ((a2 >> 28) | (a3 << 36)) & FP4_MASK52;
+        l[4][k] = a3 >> 16;
+    }
+    for (int i = 0; i < NBLOCK; i++)
+        RES->l[i] = _mm256_load_si256((const __m256i *)l[i]);
+}
+
+// x[k] = lane k / 16 mod P, reduced. Lanes must be normalized (< 2^260).
+FP4_TARGET static inline void fp4_store(oriint_t *x0, oriint_t *x1, oriint_t *x2, oriint_t *x3, const fp4_t *a) {
+    oriint_t *x[4] = { x0, x1, x2, x3 };
+    uint64_t l[NBLOCK][4] __attribute__((aligned(32)));
+
+    for (int i = 0; i < NBLOCK; i++)
+        _mm256_store_si256((__m256i *)l[i], a->l[i]);
+
+    for (int k = 0; k < 4; k++) {
+        uint64_t y0 = l[0][k] | (l[1][k] << 52);
+        uint64_t y1 = (l[1][k] >> 12) | (l[2][k] << 40);
+        uint64_t y2 = (l[2][k] >> 24) | (l[3][k] << 28);
+        uint64_t y3 = (l[3][k] >> 36) | (l[4][k] << 16);
+        uint64_t y4 = l[4][k] >> 48;
+        uint64_t r = y0 & 15;
+        unsigned __int128 c;
+
+        // y + rP = (y - r) + 5r * 2^248 is divisible by 16
+        y0 -= r;
+        c = (unsigned __int128)y3 + ((5 * r) << 56);
+        y3 = (uint64_t)c;
+        y4 += (uint64_t)(c >> 64);
+
+        x[k]->bitsu64[0] = (y0 >> 4) | (y1 << 60);
+        x[k]->bitsu64[1] = (y1 >> 4) | (y2 << 60);
+        x[k]->bitsu64[2] = (y2 >> 4) | (y3 << 60);
+        x[k]->bitsu64[3] = (y3 >> 4) | (y4 << 60);
+        x[k]->bitsu64[4] = y4 >> 4;
+        fp_reduce(x[k]);
+    }
+}
+
+// Four independent F_p2 elements, one per lane. The products avoid
+// subtracting after fp4_mul, so their outputs keep its small bound: a below
+// 48P and b below 8P give fp2x4_mul below 5P, inputs below 32P give
+// fp2x4_sqr below 7P.
+typedef struct { fp4_t re, im; } fp2x4_t;
+
+FP4_TARGET static inline void fp2x4_load(fp2x4_t *RES, const fp2_t *x0, const fp2_t *x1, const fp2_t *x2, const fp2_t *x3) {
+    fp4_load(&RES->re, &x0->re, &x1->re, &x2->re, &x3->re);
+    fp4_load(&RES->im, &x0->im, &x1->im, &x2->im, &x3->im);
+}
+
+FP4_TARGET static inline void fp2x4_store(fp2_t *x0, fp2_t *x1, fp2_t *x2, fp2_t *x3, const fp2x4_t *a) {
+    fp4_store(&x0->re, &x1->re, &x2->re, &x3->re, &a->re);
+    fp4_store(&x0->im, &x1->im, &x2->im, &x3->im, &a->im);
+}
+
+FP4_TARGET static inline void fp2x4_add(fp2x4_t *RES, const fp2x4_t *a, const fp2x4_t *b) {
+    fp4_add(&RES->re, &a->re, &b->re);
+    fp4_add(&RES->im, &a->im, &b->im);
+}
+
+FP4_TARGET static inline void fp2x4_sub(fp2x4_t *RES, const fp2x4_t *a, const fp2x4_t *b) {
+    fp4_sub(&RES->re, &a->re, &b->re);
+    fp4_sub(&RES->im, &a->im, &b->im);
+}
+
+// Schoolbook with b->im negated before the products: re = a.re b.re +
+// a.im (32P - b.im), im = a.re b.im + a.im b.re. b->im < 32P.
+FP4_TARGET static inline void fp2x4_mul(fp2x4_t *RES, const fp2x4_t *a, const fp2x4_t *b) {
+    fp4_t zero, nbi, t0, t1, t2, t3;
+
+    for (int i = 0; i < NBLOCK; i++)
+        zero.l[i] = _mm256_setzero_si256();
+    fp4_sub(&nbi, &zero, &b->im);
+    fp4_mul(&t0, &a->re, &b->re);
+    fp4_mul(&t1, &a->im, &nbi);
+    fp4_mul(&t2, &a->re, &b->im);
+    fp4_mul(&t3, &a->im, &b->re);
+    fp4_add(&RES->re, &t0, &t1);
+    fp4_add(&RES->im, &t2, &t3);
+}
+
+// re = (re + im)(re - im), im = 2 re im
+FP4_TARGET static inline void fp2x4_sqr(fp2x4_t *RES, const fp2x4_t *a) {
+    fp4_t s, d, ab;
+
+    fp4_add(&s, &a->re, &a->im);
+    fp4_sub(&d, &a->re, &a->im);
+    fp4_mul(&ab, &a->re, &a->im);
+    fp4_mul(&RES->re, &s, &d);
+    fp4_add(&RES->im, &ab, &ab);
+}
+
+// Lane k of RES = lane k of b where m is all ones there, else of a
+FP4_TARGET static inline void fp2x4_select(fp2x4_t *RES, const fp2x4_t *a, const fp2x4_t *b, __m256i m) {
+    for (int i = 0; i < NBLOCK; i++) {
+        RES->re.l[i] = _mm256_or_si256(_mm256_andnot_si256(m, a->re.l[i]), _mm256_and_si256(m, b->re.l[i]));
+        RES->im.l[i] = _mm256_or_si256(_mm256_andnot_si256(m, a->im.l[i]), _mm256_and_si256(m, b->im.l[i]));
+    }
+}
+
+#endif
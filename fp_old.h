@@ -6,6 +6,12 @@
 #include <stdint.h>
 #include <string.h>
 #include <sys/endian.h>
+#ifdef FP_DEBUG_BOUNDS
+#include <assert.h>
+#define FP_ASSERT_SMALL(s, bits) assert((s) > -((int64_t)1 << (bits)) && (s) < ((int64_t)1 << (bits)))
+#else
+#define FP_ASSERT_SMALL(s, bits) ((void)0)
+#endif
 
 /* ================================================================
    PRODUCTION-GRADE PRIME FIELD (uint64_t)
@@ -22,8 +28,8 @@
 
 /*
    We precompute MU = floor(2^64 / MODULO)
-   Must be defined in constants.h:
-   extern const __uint128_t BARRETT_MU;
+   Generated into globals_fp.c (gen_field.py core):
+   extern const uint64_t BARRETT_MU;
 */
 static inline uint64_t barrett_reduce(__uint128_t z)
 {
@@ -87,7 +93,24 @@ static inline uint64_t fp_pow_const(uint64_t a, uint64_t e)
 
 static inline uint64_t fp_inv(uint64_t a)
 {
-    return fp_pow_const(a, MODULO - 2);
+    return fp_pow_const(a, MODULO_INV_EXP);
+}
+
+/* ================================================================
+   Variable-Time Inverse (public data only: verification)
+   ================================================================ */
+static inline uint64_t fp_inv_vartime(uint64_t a)
+{
+    int64_t r0 = (int64_t)MODULO, r1 = (int64_t)(a % MODULO);
+    int64_t t0 = 0, t1 = 1;
+    while (r1 != 0) {
+        int64_t q = r0 / r1;
+        int64_t tmp = r0 - q * r1; r0 = r1; r1 = tmp;
+        tmp = t0 - q * t1; t0 = t1; t1 = tmp;
+    }
+    /* a == 0 maps to 0, same as fp_inv */
+    if (r0 != 1) return 0;
+    return (t0 < 0) ? (uint64_t)(t0 + (int64_t)MODULO) : (uint64_t)t0;
 }
 
 /* ================================================================
@@ -95,7 +118,7 @@ static inline uint64_t fp_inv(uint64_t a)
    ================================================================ */
 static inline uint64_t fp_sqrt(uint64_t a)
 {
-    uint64_t r = fp_pow_const(a, (MODULO + 1) >> 2);
+    uint64_t r = fp_pow_const(a, MODULO_SQRT_EXP);
     uint64_t check = fp_mul(r, r);
     uint64_t ok = (check == a);
     return r & (-(uint64_t)ok);
@@ -147,6 +170,15 @@ static inline fp2old_t fp2_inv(fp2old_t x)
     return (fp2old_t){ fp_mul(x.re, norm_inv), fp_sub(0, fp_mul(x.im, norm_inv)) };
 }
 
+static inline fp2old_t fp2_inv_vartime(fp2old_t x)
+{
+    uint64_t a2 = fp_mul(x.re, x.re);
+    uint64_t b2 = fp_mul(x.im, x.im);
+    uint64_t norm = fp_add(a2, b2);
+    uint64_t norm_inv = fp_inv_vartime(norm);
+    return (fp2old_t){ fp_mul(x.re, norm_inv), fp_sub(0, fp_mul(x.im, norm_inv)) };
+}
+
 /* ================================================================
    FP2 Comparison & Zero Check
    ================================================================ */
@@ -192,3 +224,80 @@ static inline fp2old_t fp2_mul_scalar(fp2old_t x, int64_t s)
     return (fp2old_t){ fp_mul(x.re, s_field), fp_mul(x.im, s_field) };
 }
 
+
+/* ================================================================
+   FP/FP2 Sum of Products (one reduction per coordinate)
+   ================================================================ */
+/*
+   Sum of x[i] * s[i] over i < n <= 4, term i subtracted when bit i of
+   neg is set. Inputs canonical. The products are summed unreduced with
+   4 * MODULO^2 added so the total stays non-negative, then reduced once;
+   gen_field.py checks 8 * MODULO^2 < 2^64 for barrett_reduce.
+*/
+static inline uint64_t fp_mul_sum(const uint64_t *x, const uint64_t *s, int n, unsigned neg)
+{
+    uint64_t acc = 4 * MODULO * MODULO;
+    for (int i = 0; i < n; i++) {
+        uint64_t mask = -(uint64_t)((neg >> i) & 1);
+        uint64_t t = x[i] * s[i];
+        acc += (t ^ mask) - mask;
+    }
+    return barrett_reduce(acc);
+}
+
+static inline fp2old_t fp2_mul_sum(const fp2old_t *x, const uint64_t *s, int n, unsigned neg)
+{
+    uint64_t pad = 4 * MODULO * MODULO;
+    uint64_t re = pad, im = pad;
+    for (int i = 0; i < n; i++) {
+        uint64_t mask = -(uint64_t)((neg >> i) & 1);
+        uint64_t tre = x[i].re * s[i];
+        uint64_t tim = x[i].im * s[i];
+        re += (tre ^ mask) - mask;
+        im += (tim ^ mask) - mask;
+    }
+    return (fp2old_t){ barrett_reduce(re), barrett_reduce(im) };
+}
+
+/* ================================================================
+   FP/FP2 Small Signed Scalars (KLPT quaternion coefficients)
+   ================================================================ */
+/*
+   s * x for |s| < 2^31 without fp_encode_signed: multiply by |s|, one
+   barrett_reduce, then a masked negation. Branchless.
+*/
+static inline uint64_t fp_mul_small(uint64_t x, int64_t s)
+{
+    uint64_t mask = (uint64_t)(s >> 63);
+    uint64_t abs_s = ((uint64_t)s ^ mask) - mask;
+    FP_ASSERT_SMALL(s, 31);
+    uint64_t r = barrett_reduce(x * abs_s);
+    return ct_select_u64(r, fp_sub(0, r), mask);
+}
+
+static inline fp2old_t fp2_mul_small(fp2old_t x, int64_t s)
+{
+    return (fp2old_t){ fp_mul_small(x.re, s), fp_mul_small(x.im, s) };
+}
+
+/*
+   fp2_mul_sum with small signed scalars: the sign of s[i] and bit i of
+   neg combine into one mask per term, and the pad is MODULO * 2^33 >=
+   4 * MODULO * 2^31 (gen_field.py checks MODULO * 2^34 < 2^64).
+*/
+static inline fp2old_t fp2_mul_sum_small(const fp2old_t *x, const int64_t *s, int n, unsigned neg)
+{
+    uint64_t pad = MODULO << 33;
+    uint64_t re = pad, im = pad;
+    for (int i = 0; i < n; i++) {
+        FP_ASSERT_SMALL(s[i], 31);
+        uint64_t sgn = (uint64_t)(s[i] >> 63);
+        uint64_t abs_s = ((uint64_t)s[i] ^ sgn) - sgn;
+        uint64_t mask = sgn ^ -(uint64_t)((neg >> i) & 1);
+        uint64_t tre = x[i].re * abs_s;
+        uint64_t tim = x[i].im * abs_s;
+        re += (tre ^ mask) - mask;
+        im += (tim ^ mask) - mask;
+    }
+    return (fp2old_t){ barrett_reduce(re), barrett_reduce(im) };
+}
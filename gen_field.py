@@ -0,0 +1,433 @@
+#!/usr/bin/env python3
+# ORISIGN V9.7 - F_p code generator
+#
+# Emits field_<name>.h (fully unrolled static inline arithmetic) and
+# field_<name>.c (precomputed constants) for one parameter set. Every symbol
+# carries the set's prefix, so several sets link into one binary and are
+# picked at compile time.
+#
+# "core" instead emits globals_fp.c: the per-prime constants of the
+# hand-written NBLOCK = 5 layer (int.h, fp.h, fp4.h) and of the single-limb
+# layer (fp_old.h), each checked here before it is written.
+#
+#   python3 gen_field.py lvl1 [lvl3 lvl5 core ...]
+
+import sys
+
+# name: (P, limb count). SQIsign NIST levels I, III and V.
+PARAMS = {
+    "lvl1": (5 * 2**248 - 1, 4),
+    "lvl3": (65 * 2**376 - 1, 6),
+    "lvl5": (27 * 2**500 - 1, 8),
+}
+
+# Hand-written layers: P in NBLOCK = 5 limbs, Montgomery radix 2^256; the
+# single-limb prime; round(2^7 * sqrt(2)), the baseline theta coordinate
+CORE_P = 5 * 2**248 - 1
+CORE_NBLOCK = 5
+CORE_R = 2**256
+CORE_MODULO = 65519
+CORE_THETA_SQRT2 = 181
+
+WINDOW = 4
+M64 = 2**64 - 1
+
+
+def is_prime(n):
+    if n < 2:
+        return False
+    d, r = n - 1, 0
+    while d % 2 == 0:
+        d //= 2
+        r += 1
+    for a in (2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47):
+        if a % n == 0:
+            continue
+        x = pow(a, d, n)
+        if x in (1, n - 1):
+            continue
+        for _ in range(r - 1):
+            x = x * x % n
+            if x == n - 1:
+                break
+        else:
+            return False
+    return True
+
+
+def limbs(x, n):
+    return [(x >> (64 * i)) & M64 for i in range(n)]
+
+
+def hexlimbs(x, n, indent="        "):
+    return ",\n".join("%s0x%016x" % (indent, l) for l in limbs(x, n))
+
+
+def window_digits(e):
+    d = []
+    while e:
+        d.append(e & ((1 << WINDOW) - 1))
+        e >>= WINDOW
+    return d[::-1]
+
+
+def gen_header(ns, p, n):
+    NS = ns.upper()
+    T = "%s_fp_t" % ns
+    mm64 = (-pow(p, -1, 2**64)) % 2**64
+    pl = limbs(p, n)
+    o = []
+    w = o.append
+
+    # q * P[j] as a 128-bit expression; all-ones limbs need no multiply
+    def mulq(j):
+        if pl[j] == M64:
+            return "((unsigned __int128)q << 64) - q"
+        return "(unsigned __int128)q * %s_P.bitsu64[%d]" % (NS, j)
+
+    w("/* * ORISIGN V9.7 - F_p for P = 0x%x" % p)
+    w(" * Generated by gen_field.py %s, do not edit." % ns)
+    w(" */")
+    w("")
+    w("#pragma once")
+    w("#include <stdbool.h>")
+    w("#include <stdint.h>")
+    w("")
+    # Carry chains: adc/sbb intrinsics on x86-64, overflow builtins elsewhere
+    # and under ORIINT_PORTABLE (see int.h)
+    w("#if defined(__x86_64__) && !defined(ORIINT_PORTABLE)")
+    w("#include <x86intrin.h>")
+    w("")
+    for op, intr in (("addc", "_addcarry_u64"), ("subb", "_subborrow_u64")):
+        w("static inline unsigned char %s_%s(unsigned char c, uint64_t a, uint64_t b, uint64_t *d) {" % (ns, op))
+        w("    return %s(c, a, b, (unsigned long long *)d);" % intr)
+        w("}")
+        w("")
+    w("#else")
+    w("")
+    for op, bi in (("addc", "__builtin_add_overflow"), ("subb", "__builtin_sub_overflow")):
+        w("static inline unsigned char %s_%s(unsigned char c, uint64_t a, uint64_t b, uint64_t *d) {" % (ns, op))
+        w("    uint64_t s;")
+        w("    bool c1 = %s(a, b, &s);" % bi)
+        w("    bool c2 = %s(s, (uint64_t)c, d);" % bi)
+        w("")
+        w("    return c1 | c2;")
+        w("}")
+        w("")
+    w("#endif")
+    w("")
+    w("#define %s_NBLOCK %d" % (NS, n))
+    w("#define %s_BITS %d" % (NS, p.bit_length()))
+    w("")
+    w("typedef union {")
+    w("    uint64_t bitsu64[%d];" % n)
+    w("    int64_t bits64[%d];" % n)
+    w("} %s;" % T)
+    w("")
+    w("extern const %s %s_P;" % (T, NS))
+    w("extern const %s %s_R1;" % (T, NS))
+    w("extern const %s %s_R2;" % (T, NS))
+    w("extern const uint64_t %s_MM64;" % NS)
+    w("extern const uint8_t %s_INV_DIGITS[%d];" % (NS, len(window_digits(p - 2))))
+    w("")
+
+    # Conditional subtraction: [0, 2P) -> [0, P)
+    w("// [0, 2P) -> [0, P), constant time")
+    w("static inline void %s_fp_reduce(%s *RES) {" % (ns, T))
+    w("    %s t;" % T)
+    w("    uint64_t m;")
+    w("    unsigned char c = 0;")
+    w("")
+    for i in range(n):
+        w("    c = %s_subb(c, RES->bitsu64[%d], %s_P.bitsu64[%d], &t.bitsu64[%d]);" % (ns, i, NS, i, i))
+    w("    m = -(uint64_t)c;")
+    for i in range(n):
+        w("    RES->bitsu64[%d] = (RES->bitsu64[%d] & m) | (t.bitsu64[%d] & ~m);" % (i, i, i))
+    w("}")
+    w("")
+
+    w("static inline void %s_fp_add(%s *RES, const %s *a, const %s *b) {" % (ns, T, T, T))
+    w("    unsigned char c = 0;")
+    w("")
+    for i in range(n):
+        w("    c = %s_addc(c, a->bitsu64[%d], b->bitsu64[%d], &RES->bitsu64[%d]);" % (ns, i, i, i))
+    w("    %s_fp_reduce(RES);" % ns)
+    w("}")
+    w("")
+
+    w("static inline void %s_fp_sub(%s *RES, const %s *a, const %s *b) {" % (ns, T, T, T))
+    w("    uint64_t m;")
+    w("    unsigned char c = 0;")
+    w("")
+    for i in range(n):
+        w("    c = %s_subb(c, a->bitsu64[%d], b->bitsu64[%d], &RES->bitsu64[%d]);" % (ns, i, i, i))
+    w("    m = -(uint64_t)c;")
+    w("    c = 0;")
+    for i in range(n):
+        w("    c = %s_addc(c, RES->bitsu64[%d], %s_P.bitsu64[%d] & m, &RES->bitsu64[%d]);" % (ns, i, NS, i, i))
+    w("}")
+    w("")
+
+    w("static inline void %s_fp_neg(%s *RES, const %s *a) {" % (ns, T, T))
+    w("    const %s z = { { 0 } };" % T)
+    w("")
+    w("    %s_fp_sub(RES, &z, a);" % ns)
+    w("}")
+    w("")
+
+    # Schoolbook product, operand scanning
+    w("// r = a * b, %d limbs" % (2 * n))
+    w("static inline void %s_fp_mul_wide(uint64_t *r, const %s *a, const %s *b) {" % (ns, T, T))
+    w("    unsigned __int128 t;")
+    w("    uint64_t c;")
+    for i in range(n):
+        w("")
+        for j in range(n):
+            acc = "" if i == 0 else " + r[%d]" % (i + j)
+            cin = "" if j == 0 else " + c"
+            w("    t = (unsigned __int128)a->bitsu64[%d] * b->bitsu64[%d]%s%s; r[%d] = (uint64_t)t; c = (uint64_t)(t >> 64);" % (j, i, acc, cin, i + j))
+        w("    r[%d] = c;" % (i + n))
+    w("}")
+    w("")
+
+    # Squaring: off-diagonal products once, doubled, plus the diagonal
+    w("// r = a^2, %d limbs: cross products once, doubled, plus the squares" % (2 * n))
+    w("static inline void %s_fp_sqr_wide(uint64_t *r, const %s *a) {" % (ns, T))
+    w("    unsigned __int128 t;")
+    w("    uint64_t c;")
+    w("    unsigned char k = 0;")
+    w("")
+    w("    r[0] = 0;")
+    w("    r[%d] = 0;" % (2 * n - 1))
+    for i in range(n - 1):
+        w("")
+        for j in range(i + 1, n):
+            acc = "" if i == 0 else " + r[%d]" % (i + j)
+            cin = "" if j == i + 1 else " + c"
+            w("    t = (unsigned __int128)a->bitsu64[%d] * a->bitsu64[%d]%s%s; r[%d] = (uint64_t)t; c = (uint64_t)(t >> 64);" % (j, i, acc, cin, i + j))
+        w("    r[%d] = c;" % (i + n))
+    w("")
+    for k in range(2 * n - 1, 0, -1):
+        w("    r[%d] = (r[%d] << 1) | (r[%d] >> 63);" % (k, k, k - 1))
+    w("    r[0] = 0;")
+    w("")
+    for i in range(n):
+        w("    t = (unsigned __int128)a->bitsu64[%d] * a->bitsu64[%d];" % (i, i))
+        w("    k = %s_addc(k, r[%d], (uint64_t)t, &r[%d]);" % (ns, 2 * i, 2 * i))
+        w("    k = %s_addc(k, r[%d], (uint64_t)(t >> 64), &r[%d]);" % (ns, 2 * i + 1, 2 * i + 1))
+    w("}")
+    w("")
+
+    # Word-by-word Montgomery reduction
+    w("// Montgomery reduction r * 2^-%d mod P into [0, P); r < P * 2^%d is destroyed" % (64 * n, 64 * n))
+    w("static inline void %s_fp_redc(%s *RES, uint64_t *r) {" % (ns, T))
+    w("    unsigned __int128 t;")
+    w("    uint64_t q, c, e = 0;")
+    for i in range(n):
+        w("")
+        w("    q = r[%d]%s;" % (i, "" if mm64 == 1 else " * %s_MM64" % NS))
+        for j in range(n):
+            cin = "" if j == 0 else " + c"
+            w("    t = %s + r[%d]%s; r[%d] = (uint64_t)t; c = (uint64_t)(t >> 64);" % (mulq(j), i + j, cin, i + j))
+        w("    t = (unsigned __int128)r[%d] + c + e; r[%d] = (uint64_t)t; e = (uint64_t)(t >> 64);" % (i + n, i + n))
+    w("")
+    for i in range(n):
+        w("    RES->bitsu64[%d] = r[%d];" % (i, i + n))
+    w("    %s_fp_reduce(RES);" % ns)
+    w("}")
+    w("")
+
+    # Interleaved (CIOS) product and reduction on named locals; cheaper than
+    # mul_wide + redc when nothing is accumulated in between
+    w("// RES = a * b * 2^-%d mod P, a, b < P" % (64 * n))
+    w("static inline void %s_fp_mul(%s *RES, const %s *a, const %s *b) {" % (ns, T, T, T))
+    w("    unsigned __int128 t;")
+    w("    uint64_t q, c, %s;" % ", ".join("t%d = 0" % i for i in range(n + 2)))
+    for i in range(n):
+        w("")
+        for j in range(n):
+            cin = "" if j == 0 else " + c"
+            w("    t = (unsigned __int128)a->bitsu64[%d] * b->bitsu64[%d] + t%d%s; t%d = (uint64_t)t; c = (uint64_t)(t >> 64);" % (j, i, j, cin, j))
+        w("    t = (unsigned __int128)t%d + c; t%d = (uint64_t)t; t%d = (uint64_t)(t >> 64);" % (n, n, n + 1))
+        w("    q = t0%s;" % ("" if mm64 == 1 else " * %s_MM64" % NS))
+        for j in range(n):
+            dst = "c = (uint64_t)(t >> 64);" if j == 0 else "t%d = (uint64_t)t; c = (uint64_t)(t >> 64);" % (j - 1)
+            cin = "" if j == 0 else " + c"
+            w("    t = %s + t%d%s; %s" % (mulq(j), j, cin, dst))
+        w("    t = (unsigned __int128)t%d + c; t%d = (uint64_t)t; t%d = t%d + (uint64_t)(t >> 64);" % (n, n - 1, n, n + 1))
+    w("")
+    for i in range(n):
+        w("    RES->bitsu64[%d] = t%d;" % (i, i))
+    w("    %s_fp_reduce(RES);" % ns)
+    w("}")
+    w("")
+
+    w("static inline void %s_fp_sqr(%s *RES, const %s *a) {" % (ns, T, T))
+    w("    uint64_t r[%d];" % (2 * n))
+    w("")
+    w("    %s_fp_sqr_wide(r, a);" % ns)
+    w("    %s_fp_redc(RES, r);" % ns)
+    w("}")
+    w("")
+
+    w("static inline void %s_fp_to_mont(%s *RES, const %s *a) {" % (ns, T, T))
+    w("    %s_fp_mul(RES, a, &%s_R2);" % (ns, NS))
+    w("}")
+    w("")
+
+    w("static inline void %s_fp_from_mont(%s *RES, const %s *a) {" % (ns, T, T))
+    w("    uint64_t r[%d] = { 0 };" % (2 * n))
+    w("")
+    for i in range(n):
+        w("    r[%d] = a->bitsu64[%d];" % (i, i))
+    w("    %s_fp_redc(RES, r);" % ns)
+    w("}")
+    w("")
+
+    # Fermat inversion, fixed window over the public exponent P - 2
+    w("// a^(P-2), Montgomery form in and out; 0 maps to 0. The exponent is")
+    w("// public, so the %d-bit window digits drive the loop directly." % WINDOW)
+    w("static inline void %s_fp_inv(%s *RES, const %s *a) {" % (ns, T, T))
+    w("    %s tab[%d];" % (T, 1 << WINDOW))
+    w("    %s x;" % T)
+    w("")
+    w("    tab[0] = %s_R1;" % NS)
+    w("    tab[1] = *a;")
+    w("    for (int i = 2; i < %d; i++)" % (1 << WINDOW))
+    w("        %s_fp_mul(&tab[i], &tab[i - 1], a);" % ns)
+    w("")
+    w("    x = tab[%s_INV_DIGITS[0]];" % NS)
+    w("    for (int i = 1; i < %d; i++) {" % len(window_digits(p - 2)))
+    for _ in range(WINDOW):
+        w("        %s_fp_sqr(&x, &x);" % ns)
+    w("        if (%s_INV_DIGITS[i])" % NS)
+    w("            %s_fp_mul(&x, &x, &tab[%s_INV_DIGITS[i]]);" % (ns, NS))
+    w("    }")
+    w("    *RES = x;")
+    w("}")
+    w("")
+    return "\n".join(o)
+
+
+def gen_source(ns, p, n):
+    NS = ns.upper()
+    T = "%s_fp_t" % ns
+    R = 2 ** (64 * n)
+    mm64 = (-pow(p, -1, 2**64)) % 2**64
+    d = window_digits(p - 2)
+    o = []
+    w = o.append
+
+    w("/* * ORISIGN V9.7 - F_p constants for P = 0x%x" % p)
+    w(" * Generated by gen_field.py %s, do not edit." % ns)
+    w(" */")
+    w("")
+    w('#include "field_%s.h"' % ns)
+    w("")
+    w("const uint64_t %s_MM64 = 0x%016x;" % (NS, mm64))
+    for name, val in (("P", p), ("R1", R % p), ("R2", R * R % p)):
+        w("const %s %s_%s = {" % (T, NS, name))
+        w("    .bitsu64 = {")
+        w(hexlimbs(val, n))
+        w("    }")
+        w("};")
+    w("// P - 2 in base 2^%d, most significant digit first" % WINDOW)
+    w("const uint8_t %s_INV_DIGITS[%d] = {" % (NS, len(d)))
+    for i in range(0, len(d), 16):
+        w("    " + ", ".join("%d" % x for x in d[i:i + 16]) + ",")
+    w("};")
+    w("")
+    return "\n".join(o)
+
+
+def oriint(name, x, comment=None):
+    o = ["const oriint_t %s = {" % name]
+    if comment:
+        o.insert(0, "// " + comment)
+    o.append("    .bitsu64 = {")
+    o.append(hexlimbs(x, CORE_NBLOCK))
+    o.append("    }")
+    o.append("};")
+    return o
+
+
+def r52(name, x):
+    l = [(x >> (52 * i)) & (2**52 - 1) for i in range(5)]
+    assert x < 2**260
+    o = ["const uint64_t %s[5] = {" % name]
+    o.append(",\n".join("    0x%016x" % v for v in l))
+    o.append("};")
+    return o
+
+
+def gen_core():
+    p, R, m = CORE_P, CORE_R, CORE_MODULO
+    mm64 = (-pow(p, -1, 2**64)) % 2**64
+    mu = 2**64 // m
+
+    # Everything int.h/fp.h/fp4.h/fp_old.h take for granted
+    assert is_prime(p) and p % 4 == 3 and p < 2**251        # fp_packed_t: 4 limbs
+    assert (p * mm64) % 2**64 == 2**64 - 1 and mm64 == 1   # oriint_redc_512
+    assert p >> 248 == 4 and (p + 1) % 2**248 == 0          # oriint_fold_p
+    assert 16 * p < 2**256 and 128 * p < 2**260             # P16, fp4.h pads
+    assert is_prime(m) and m % 4 == 3 and m < 2**63         # fp_old.h
+    assert 8 * m * m < 2**64 and m * 2**34 < 2**64          # barrett_reduce, fp2_mul_sum(_small)
+    assert round(2**7 * 2**0.5) == CORE_THETA_SQRT2
+
+    o = []
+    w = o.extend
+    o += ["/* * ORISIGN V9.7 - PER-PRIME CONSTANTS",
+          " * Generated by gen_field.py core, do not edit.",
+          " */",
+          "",
+          '#include "globals.h"',
+          '#include "types.h"',
+          "#include <stdint.h>",
+          "",
+          "// Single-limb layer (fp_old.h)",
+          "const uint64_t MODULO = %d;" % m,
+          "const uint64_t BARRETT_MU = 0x%016x;   // floor(2^64 / MODULO)" % mu,
+          "const uint64_t MODULO_INV_EXP = %d;   // MODULO - 2" % (m - 2),
+          "const uint64_t MODULO_SQRT_EXP = %d;  // (MODULO + 1) / 4" % ((m + 1) // 4),
+          "const uint64_t NIST_THETA_SQRT2 = %d;   // round(2^7 * sqrt(2))" % CORE_THETA_SQRT2,
+          "",
+          "// P = 5*2^248 - 1, Montgomery radix R = 2^256",
+          "const uint64_t MM64 = 0x%016x;   // -P^-1 mod 2^64" % mm64,
+          "const int Msize = %d;" % ((p.bit_length() + 63) // 64)]
+    w(oriint("P", p))
+    w(oriint("P4", 4 * p))
+    w(oriint("P16", 16 * p))
+    w(oriint("R1", R % p, "R mod P: Montgomery form of one"))
+    w(oriint("R2", R * R % p, "R^2 mod P"))
+    w(oriint("R3", R**3 % p, "R^3 mod P"))
+    w(oriint("P_INV_EXP", p - 2, "P - 2"))
+    w(oriint("P_SQRT_EXP", (p + 1) // 4, "(P + 1) / 4"))
+    o.append("")
+    o.append("// Radix 2^52 limbs of P, 32P and 128P for the four-lane backend (fp4.h)")
+    w(r52("P_R52", p))
+    w(r52("P32_R52", 32 * p))
+    w(r52("P128_R52", 128 * p))
+    o.append("")
+    return "\n".join(o)
+
+
+def main():
+    names = sys.argv[1:] or sorted(PARAMS)
+    for ns in names:
+        if ns == "core":
+            with open("globals_fp.c", "w") as f:
+                f.write(gen_core())
+            continue
+        if ns not in PARAMS:
+            sys.exit("gen_field.py: unknown parameter set '%s' (have %s, core)" % (ns, ", ".join(sorted(PARAMS))))
+        p, n = PARAMS[ns]
+        # a + b < 2P must fit in n limbs (this also keeps redc below 2P)
+        assert p.bit_length() < 64 * n and is_prime(p)
+        with open("field_%s.h" % ns, "w") as f:
+            f.write(gen_header(ns, p, n))
+        with open("field_%s.c" % ns, "w") as f:
+            f.write(gen_source(ns, p, n))
+
+
+if __name__ == "__main__":
+    main()
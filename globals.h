@@ -5,11 +5,22 @@
 
 extern const uint64_t MODULO;
 extern const uint64_t BARRETT_MU;
+extern const uint64_t MODULO_INV_EXP;
+extern const uint64_t MODULO_SQRT_EXP;
 extern const uint64_t NIST_NORM_IDEAL;
 extern const uint64_t NIST_THETA_SQRT2;
 extern const uint64_t MM64;
 extern const oriint_t P;
+extern const oriint_t P4;
+extern const oriint_t P16;
 extern const int Msize;
 extern const oriint_t R2;
+extern const oriint_t R1;
+extern const oriint_t R3;
+extern const oriint_t P_INV_EXP;
+extern const oriint_t P_SQRT_EXP;
 extern const uint64_t MSK62;
+extern const uint64_t P_R52[5];
+extern const uint64_t P32_R52[5];
+extern const uint64_t P128_R52[5];
 
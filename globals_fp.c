@@ -0,0 +1,118 @@
+/* * ORISIGN V9.7 - PER-PRIME CONSTANTS
+ * Generated by gen_field.py core, do not edit.
+ */
+
+#include "globals.h"
+#include "types.h"
+#include <stdint.h>
+
+// Single-limb layer (fp_old.h)
+const uint64_t MODULO = 65519;
+const uint64_t BARRETT_MU = 0x0001001101211332;   // floor(2^64 / MODULO)
+const uint64_t MODULO_INV_EXP = 65517;   // MODULO - 2
+const uint64_t MODULO_SQRT_EXP = 16380;  // (MODULO + 1) / 4
+const uint64_t NIST_THETA_SQRT2 = 181;   // round(2^7 * sqrt(2))
+
+// P = 5*2^248 - 1, Montgomery radix R = 2^256
+const uint64_t MM64 = 0x0000000000000001;   // -P^-1 mod 2^64
+const int Msize = 4;
+const oriint_t P = {
+    .bitsu64 = {
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0x04ffffffffffffff,
+        0x0000000000000000
+    }
+};
+const oriint_t P4 = {
+    .bitsu64 = {
+        0xfffffffffffffffc,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0x13ffffffffffffff,
+        0x0000000000000000
+    }
+};
+const oriint_t P16 = {
+    .bitsu64 = {
+        0xfffffffffffffff0,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0x4fffffffffffffff,
+        0x0000000000000000
+    }
+};
+// R mod P: Montgomery form of one
+const oriint_t R1 = {
+    .bitsu64 = {
+        0x0000000000000033,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0100000000000000,
+        0x0000000000000000
+    }
+};
+// R^2 mod P
+const oriint_t R2 = {
+    .bitsu64 = {
+        0x3333333333333d70,
+        0x3333333333333333,
+        0x3333333333333333,
+        0x0333333333333333,
+        0x0000000000000000
+    }
+};
+// R^3 mod P
+const oriint_t R3 = {
+    .bitsu64 = {
+        0x70a3d70a3d72b020,
+        0xd70a3d70a3d70a3d,
+        0x3d70a3d70a3d70a3,
+        0x03d70a3d70a3d70a,
+        0x0000000000000000
+    }
+};
+// P - 2
+const oriint_t P_INV_EXP = {
+    .bitsu64 = {
+        0xfffffffffffffffd,
+        0xffffffffffffffff,
+        0xffffffffffffffff,
+        0x04ffffffffffffff,
+        0x0000000000000000
+    }
+};
+// (P + 1) / 4
+const oriint_t P_SQRT_EXP = {
+    .bitsu64 = {
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0000000000000000,
+        0x0140000000000000,
+        0x0000000000000000
+    }
+};
+
+// Radix 2^52 limbs of P, 32P and 128P for the four-lane backend (fp4.h)
+const uint64_t P_R52[5] = {
+    0x000fffffffffffff,
+    0x000fffffffffffff,
+    0x000fffffffffffff,
+    0x000fffffffffffff,
+    0x000004ffffffffff
+};
+const uint64_t P32_R52[5] = {
+    0x000fffffffffffe0,
+    0x000fffffffffffff,
+    0x000fffffffffffff,
+    0x000fffffffffffff,
+    0x00009fffffffffff
+};
+const uint64_t P128_R52[5] = {
+    0x000fffffffffff80,
+    0x000fffffffffffff,
+    0x000fffffffffffff,
+    0x000fffffffffffff,
+    0x00027fffffffffff
+};
@@ -6,6 +6,75 @@
 #include <stdio.h>
 #include <string.h>
 
+// ORIINT_PORTABLE selects plain C for the word primitives: unsigned __int128
+// products and carry builtins instead of x86 inline asm, no cpuid dispatch.
+// It is forced on for every target other than x86-64.
+#if !defined(ORIINT_PORTABLE) && !defined(__x86_64__)
+#define ORIINT_PORTABLE
+#endif
+
+#ifndef ORIINT_PORTABLE
+#include <cpuid.h>
+#endif
+
+#ifdef ORIINT_PORTABLE
+
+static inline uint64_t oriint_umul128(uint64_t a, uint64_t b, uint64_t *hi) {
+    unsigned __int128 p = (unsigned __int128)a * b;
+
+    *hi = (uint64_t)(p >> 64);
+    return (uint64_t)p;
+}
+
+// n in [0, 64), as shrd/shld
+static inline uint64_t oriint_shiftright128(uint64_t a, uint64_t b, unsigned char n) {
+    return (uint64_t)((((unsigned __int128)b << 64) | a) >> n);
+}
+
+static inline uint64_t oriint_shiftleft128(uint64_t a, uint64_t b, unsigned char n) {
+    return (uint64_t)(((((unsigned __int128)b << 64) | a) << n) >> 64);
+}
+
+// clang (and gcc >= 14) lower __builtin_addcll/subcll to adc/sbb (adcs/sbcs
+// on aarch64) chains; the overflow-builtin pair is the generic fallback.
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_addcll) && __has_builtin(__builtin_subcll)
+#define ORIINT_HAVE_ADDC
+#endif
+#endif
+
+static inline uint64_t oriint_addcarry_u64(uint64_t c, uint64_t a, uint64_t b, uint64_t *d) {
+#ifdef ORIINT_HAVE_ADDC
+    unsigned long long co;
+
+    *d = __builtin_addcll(a, b, c, &co);
+    return co;
+#else
+    uint64_t s;
+    bool c1 = __builtin_add_overflow(a, b, &s);
+    bool c2 = __builtin_add_overflow(s, c, d);
+
+    return c1 | c2;
+#endif
+}
+
+static inline uint64_t oriint_subborrow_u64(uint64_t c, uint64_t a, uint64_t b, uint64_t *d) {
+#ifdef ORIINT_HAVE_ADDC
+    unsigned long long co;
+
+    *d = __builtin_subcll(a, b, c, &co);
+    return co;
+#else
+    uint64_t s;
+    bool c1 = __builtin_sub_overflow(a, b, &s);
+    bool c2 = __builtin_sub_overflow(s, c, d);
+
+    return c1 | c2;
+#endif
+}
+
+#else
+
 static inline uint64_t oriint_umul128(uint64_t a, uint64_t b, uint64_t *hi) {
     uint64_t lo;
     uint64_t h;
@@ -52,6 +121,8 @@ static inline uint64_t oriint_subborrow_u64(uint64_t c, uint64_t a, uint64_t b,
     return __builtin_ia32_subborrow_u64(c, a, b, (long long unsigned int*)d);
 }
 
+#endif
+
 static inline void oriint_set(oriint_t *a, const oriint_t *b) {
     a->bitsu64[0] = b->bitsu64[0];
     a->bitsu64[1] = b->bitsu64[1];
@@ -257,52 +328,382 @@ static inline void oriint_modmul_montgomerry(oriint_t *RES, oriint_t *a) {
   	oriint_montgomerymult(RES,&R2,&p);
 }
 
-static inline void oriint_modmul(oriint_t *RES, oriint_t *a) {
-	  uint64_t ah, al, c;
+static inline void oriint_mul_512_generic(uint64_t *r512, const uint64_t *x, const uint64_t *y) {
+	  uint64_t c;
 	  uint64_t t[5];
-	  uint64_t r512[8];
 	  r512[5] = 0;
 	  r512[6] = 0;
 	  r512[7] = 0;
 
-	  oriint_imm_umul(RES->bitsu64, a->bitsu64[0], r512);
-	  oriint_imm_umul(RES->bitsu64, a->bitsu64[1], t);
+	  oriint_imm_umul(x, y[0], r512);
+	  oriint_imm_umul(x, y[1], t);
 	  c = oriint_addcarry_u64(0, r512[1], t[0], r512 + 1);
 	  c = oriint_addcarry_u64(c, r512[2], t[1], r512 + 2);
 	  c = oriint_addcarry_u64(c, r512[3], t[2], r512 + 3);
 	  c = oriint_addcarry_u64(c, r512[4], t[3], r512 + 4);
 	  c = oriint_addcarry_u64(c, r512[5], t[4], r512 + 5);
-	  oriint_imm_umul(RES->bitsu64, a->bitsu64[2], t);
+	  oriint_imm_umul(x, y[2], t);
 	  c = oriint_addcarry_u64(0, r512[2], t[0], r512 + 2);
 	  c = oriint_addcarry_u64(c, r512[3], t[1], r512 + 3);
 	  c = oriint_addcarry_u64(c, r512[4], t[2], r512 + 4);
 	  c = oriint_addcarry_u64(c, r512[5], t[3], r512 + 5);
 	  c = oriint_addcarry_u64(c, r512[6], t[4], r512 + 6);
-	  oriint_imm_umul(RES->bitsu64, a->bitsu64[3], t);
+	  oriint_imm_umul(x, y[3], t);
 	  c = oriint_addcarry_u64(0, r512[3], t[0], r512 + 3);
 	  c = oriint_addcarry_u64(c, r512[4], t[1], r512 + 4);
 	  c = oriint_addcarry_u64(c, r512[5], t[2], r512 + 5);
 	  c = oriint_addcarry_u64(c, r512[6], t[3], r512 + 6);
 	  c = oriint_addcarry_u64(c, r512[7], t[4], r512 + 7);
+}
+
+// Portable backend: one __int128 multiply-accumulate per limb pair. Each
+// step is a*b + r + c < 2^128, so no carry flag is needed; clang maps it to
+// mul/adc on x86-64 and mul/umulh/adcs on aarch64.
+static inline void oriint_mul_512_portable(uint64_t *r512, const uint64_t *x, const uint64_t *y) {
+    unsigned __int128 t;
+    uint64_t a[4] = { x[0], x[1], x[2], x[3] };
+    uint64_t r[8];
+    uint64_t c;
+
+    // Locals first: r512 may alias x or y
+    #pragma GCC unroll 4
+    for (int i = 0; i < 4; i++) {
+        c = 0;
+        #pragma GCC unroll 4
+        for (int j = 0; j < 4; j++) {
+            t = (unsigned __int128)a[j] * y[i] + (i ? r[i + j] : 0) + c;
+            r[i + j] = (uint64_t)t;
+            c = (uint64_t)(t >> 64);
+        }
+        r[i + 4] = c;
+    }
+    for (int i = 0; i < 8; i++)
+        r512[i] = r[i];
+}
+
+#ifndef ORIINT_PORTABLE
+
+// BMI2/ADX backend: mulx leaves the flags alone, so each row accumulates the
+// low halves on the CF chain (adcx) and the high halves on the OF chain
+// (adox) in parallel.
+static inline void oriint_mul_512_mulx(uint64_t *r512, const uint64_t *x, const uint64_t *y) {
+    __asm__ volatile (
+        // row 0: r8..r12
+        "movq 0(%[y]), %%rdx;"
+        "xorl %%eax, %%eax;"
+        "mulxq 0(%[x]), %%r8, %%r9;"
+        "mulxq 8(%[x]), %%rcx, %%r10;"  "adcxq %%rcx, %%r9;"
+        "mulxq 16(%[x]), %%rcx, %%r11;" "adcxq %%rcx, %%r10;"
+        "mulxq 24(%[x]), %%rcx, %%r12;" "adcxq %%rcx, %%r11;"
+        "adcxq %%rax, %%r12;"
+        "movq %%r8, 0(%[r]);"
+
+        // row 1: r9..r12, r8
+        "movq 8(%[y]), %%rdx;"
+        "xorl %%eax, %%eax;"
+        "mulxq 0(%[x]), %%rcx, %%rbx;"  "adcxq %%rcx, %%r9;"  "adoxq %%rbx, %%r10;"
+        "mulxq 8(%[x]), %%rcx, %%rbx;"  "adcxq %%rcx, %%r10;" "adoxq %%rbx, %%r11;"
+        "mulxq 16(%[x]), %%rcx, %%rbx;" "adcxq %%rcx, %%r11;" "adoxq %%rbx, %%r12;"
+        "mulxq 24(%[x]), %%rcx, %%r8;"  "adcxq %%rcx, %%r12;" "adoxq %%rax, %%r8;"
+        "adcxq %%rax, %%r8;"
+        "movq %%r9, 8(%[r]);"
+
+        // row 2: r10..r12, r8, r9
+        "movq 16(%[y]), %%rdx;"
+        "xorl %%eax, %%eax;"
+        "mulxq 0(%[x]), %%rcx, %%rbx;"  "adcxq %%rcx, %%r10;" "adoxq %%rbx, %%r11;"
+        "mulxq 8(%[x]), %%rcx, %%rbx;"  "adcxq %%rcx, %%r11;" "adoxq %%rbx, %%r12;"
+        "mulxq 16(%[x]), %%rcx, %%rbx;" "adcxq %%rcx, %%r12;" "adoxq %%rbx, %%r8;"
+        "mulxq 24(%[x]), %%rcx, %%r9;"  "adcxq %%rcx, %%r8;"  "adoxq %%rax, %%r9;"
+        "adcxq %%rax, %%r9;"
+        "movq %%r10, 16(%[r]);"
+
+        // row 3: r11, r12, r8, r9, r10
+        "movq 24(%[y]), %%rdx;"
+        "xorl %%eax, %%eax;"
+        "mulxq 0(%[x]), %%rcx, %%rbx;"  "adcxq %%rcx, %%r11;" "adoxq %%rbx, %%r12;"
+        "mulxq 8(%[x]), %%rcx, %%rbx;"  "adcxq %%rcx, %%r12;" "adoxq %%rbx, %%r8;"
+        "mulxq 16(%[x]), %%rcx, %%rbx;" "adcxq %%rcx, %%r8;"  "adoxq %%rbx, %%r9;"
+        "mulxq 24(%[x]), %%rcx, %%r10;" "adcxq %%rcx, %%r9;"  "adoxq %%rax, %%r10;"
+        "adcxq %%rax, %%r10;"
+        "movq %%r11, 24(%[r]);"
+        "movq %%r12, 32(%[r]);"
+        "movq %%r8, 40(%[r]);"
+        "movq %%r9, 48(%[r]);"
+        "movq %%r10, 56(%[r]);"
+        :
+        : [r] "r"(r512), [x] "r"(x), [y] "r"(y)
+        : "rax", "rbx", "rcx", "rdx", "r8", "r9", "r10", "r11", "r12", "cc", "memory"
+    );
+}
+
+#endif
+
+// Backend selection, done once at startup from cpuid leaf 7: BMI2 + ADX for
+// the mulx product, AVX-512 F/VL/IFMA (with OS-enabled zmm state) for fp4.h.
+// Both stay false under ORIINT_PORTABLE.
+static bool oriint_cpu_mulx __attribute__((unused)) = false;
+static bool oriint_cpu_ifma __attribute__((unused)) = false;
+
+#ifndef ORIINT_PORTABLE
+__attribute__((constructor)) static void oriint_setup_cpu(void) {
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int xcr0_lo, xcr0_hi;
+    bool os_avx512 = false;
+
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && ((ecx >> 27) & 1)) {
+        __asm__ ("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        // SSE, AVX, opmask, ZMM_Hi256 and Hi16_ZMM state
+        os_avx512 = (xcr0_lo & 0xe6) == 0xe6;
+    }
+
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        oriint_cpu_mulx = ((ebx >> 8) & 1) && ((ebx >> 19) & 1);
+        oriint_cpu_ifma = os_avx512 && ((ebx >> 16) & 1) && ((ebx >> 21) & 1) && ((ebx >> 31) & 1);
+    }
+}
+
+#endif
+
+static inline void oriint_mul_512(uint64_t *r512, const uint64_t *x, const uint64_t *y) {
+#ifdef ORIINT_PORTABLE
+    oriint_mul_512_portable(r512, x, y);
+#else
+    if (oriint_cpu_mulx)
+        oriint_mul_512_mulx(r512, x, y);
+    else
+        oriint_mul_512_generic(r512, x, y);
+#endif
+}
+
+// Squaring: the six cross products are computed once and doubled, then the
+// four diagonal squares are added (10 multiplies instead of 16).
+static inline void oriint_sqr_512(uint64_t *r512, const uint64_t *x) {
+	  uint64_t c, h, lo, carry;
+	  uint64_t u[3];
+
+	  // x0 * (x1, x2, x3) at limb 1
+	  r512[0] = 0;
+	  r512[1] = oriint_umul128(x[0], x[1], &h); carry = h;
+	  c = oriint_addcarry_u64(0, oriint_umul128(x[0], x[2], &h), carry, r512 + 2); carry = h;
+	  c = oriint_addcarry_u64(c, oriint_umul128(x[0], x[3], &h), carry, r512 + 3);
+	  r512[4] = h + c;
+
+	  // x1 * (x2, x3) at limb 3
+	  u[0] = oriint_umul128(x[1], x[2], &h); carry = h;
+	  c = oriint_addcarry_u64(0, oriint_umul128(x[1], x[3], &h), carry, u + 1);
+	  u[2] = h + c;
+	  c = oriint_addcarry_u64(0, r512[3], u[0], r512 + 3);
+	  c = oriint_addcarry_u64(c, r512[4], u[1], r512 + 4);
+	  c = oriint_addcarry_u64(c, 0ULL, u[2], r512 + 5);
+	  r512[6] = c;
+
+	  // x2 * x3 at limb 5
+	  lo = oriint_umul128(x[2], x[3], &h);
+	  c = oriint_addcarry_u64(0, r512[5], lo, r512 + 5);
+	  c = oriint_addcarry_u64(c, r512[6], h, r512 + 6);
+	  r512[7] = c;
+
+	  // Double the cross products
+	  r512[7] = oriint_shiftleft128(r512[6], r512[7], 1);
+	  r512[6] = oriint_shiftleft128(r512[5], r512[6], 1);
+	  r512[5] = oriint_shiftleft128(r512[4], r512[5], 1);
+	  r512[4] = oriint_shiftleft128(r512[3], r512[4], 1);
+	  r512[3] = oriint_shiftleft128(r512[2], r512[3], 1);
+	  r512[2] = oriint_shiftleft128(r512[1], r512[2], 1);
+	  r512[1] = r512[1] << 1;
+
+	  // Diagonal squares
+	  lo = oriint_umul128(x[0], x[0], &h);
+	  c = oriint_addcarry_u64(0, r512[0], lo, r512 + 0);
+	  c = oriint_addcarry_u64(c, r512[1], h, r512 + 1);
+	  lo = oriint_umul128(x[1], x[1], &h);
+	  c = oriint_addcarry_u64(c, r512[2], lo, r512 + 2);
+	  c = oriint_addcarry_u64(c, r512[3], h, r512 + 3);
+	  lo = oriint_umul128(x[2], x[2], &h);
+	  c = oriint_addcarry_u64(c, r512[4], lo, r512 + 4);
+	  c = oriint_addcarry_u64(c, r512[5], h, r512 + 5);
+	  lo = oriint_umul128(x[3], x[3], &h);
+	  c = oriint_addcarry_u64(c, r512[6], lo, r512 + 6);
+	  oriint_addcarry_u64(c, r512[7], h, r512 + 7);
+}
+
+// P = 5*2^248 - 1, so 5*2^248 == 1 (mod P). Writing x = H*2^248 + L with
+// H = 5q + r gives x == q + r*2^248 + L (mod P): a fold costs a division
+// of H by the constant 5 and no multiplication by P.
+
+// Fold x < 2^312 into [0, P).
+static inline void oriint_fold_p(oriint_t *RES) {
+	  oriint_t t;
+	  uint64_t h, q, r, c;
+
+	  h = oriint_shiftright128(RES->bitsu64[3], RES->bitsu64[4], 56);
+	  q = h / 5;
+	  r = h - 5 * q;
+
+	  c = oriint_addcarry_u64(0, RES->bitsu64[0], q, RES->bitsu64 + 0);
+	  c = oriint_addcarry_u64(c, RES->bitsu64[1], 0ULL, RES->bitsu64 + 1);
+	  c = oriint_addcarry_u64(c, RES->bitsu64[2], 0ULL, RES->bitsu64 + 2);
+	  c = oriint_addcarry_u64(c, RES->bitsu64[3] & 0x00ffffffffffffffULL, r << 56, RES->bitsu64 + 3);
+	  RES->bitsu64[4] = c;
+
+	  // Here RES < P + 2^62 < 2P
+	  oriint_sub_3(&t, RES, &P);
+	  oriint_select_mask(RES, &t, RES, (uint64_t)(t.bits64[NBLOCK - 1] >> 63));
+}
+
+// Reduce a 512-bit product into [0, P).
+static inline void oriint_reduce_512(oriint_t *RES, const uint64_t *r512) {
+	  uint64_t h[5];
+	  uint64_t q[5];
+	  uint64_t r, s, b, lo, c;
+
+	  h[0] = oriint_shiftright128(r512[3], r512[4], 56);
+	  h[1] = oriint_shiftright128(r512[4], r512[5], 56);
+	  h[2] = oriint_shiftright128(r512[5], r512[6], 56);
+	  h[3] = oriint_shiftright128(r512[6], r512[7], 56);
+	  h[4] = r512[7] >> 56;
+
+	  // 2^64 == 1 (mod 5), so H mod 5 is the limb sum mod 5
+	  r = (h[0] % 5) + (h[1] % 5) + (h[2] % 5) + (h[3] % 5) + h[4];
+	  r %= 5;
+
+	  // q = (H - r) / 5, exact division: multiply by 5^-1 mod 2^64 and
+	  // carry hi(5 * q_i) as a borrow into the next limb
+	  b = r;
+	  for (int i = 0; i < NBLOCK; i++) {
+		    s = h[i] - b;
+		    b = (h[i] < b);
+		    q[i] = s * 0xcccccccccccccccdULL;
+		    lo = q[i] + (q[i] << 2);
+		    b += (q[i] >> 62) + (lo < q[i]);
+	  }
+
+	  c = oriint_addcarry_u64(0, r512[0], q[0], RES->bitsu64 + 0);
+	  c = oriint_addcarry_u64(c, r512[1], q[1], RES->bitsu64 + 1);
+	  c = oriint_addcarry_u64(c, r512[2], q[2], RES->bitsu64 + 2);
+	  c = oriint_addcarry_u64(c, r512[3] & 0x00ffffffffffffffULL, q[3], RES->bitsu64 + 3);
+	  oriint_addcarry_u64(c, 0ULL, q[4], RES->bitsu64 + 4);
+	  c = oriint_addcarry_u64(0, RES->bitsu64[3], r << 56, RES->bitsu64 + 3);
+	  RES->bitsu64[4] += c;
+
+	  // Here RES < 2^263
+	  oriint_fold_p(RES);
+}
+
+// Montgomery reduction T * 2^-256 mod P into [0, P). MM64 == 1 and the low
+// 248 bits of P are all ones, so -P^-1 mod 2^256 = 1 + 5*2^248: the quotient
+// M is T_lo with only its top byte adjusted, and M*P = 5M*2^248 - M needs
+// no multiply. The result is T_hi + carry(M) + (5M >> 8).
+static inline void oriint_redc_512(oriint_t *RES, const uint64_t *r512) {
+	  uint64_t m3, k, c;
+	  uint64_t m5[5];
+
+	  k = (r512[0] * 5) & 0xff;
+	  c = oriint_addcarry_u64(0, r512[3], k << 56, &m3);
+
+	  // 5M = M + 4M
+	  m5[0] = r512[0] << 2;
+	  m5[1] = oriint_shiftleft128(r512[0], r512[1], 2);
+	  m5[2] = oriint_shiftleft128(r512[1], r512[2], 2);
+	  m5[3] = oriint_shiftleft128(r512[2], m3, 2);
+	  m5[4] = m3 >> 62;
+	  uint64_t cc = 0;
+	  cc = oriint_addcarry_u64(cc, m5[0], r512[0], m5 + 0);
+	  cc = oriint_addcarry_u64(cc, m5[1], r512[1], m5 + 1);
+	  cc = oriint_addcarry_u64(cc, m5[2], r512[2], m5 + 2);
+	  cc = oriint_addcarry_u64(cc, m5[3], m3, m5 + 3);
+	  m5[4] += cc;
+
+	  RES->bitsu64[0] = oriint_shiftright128(m5[0], m5[1], 8);
+	  RES->bitsu64[1] = oriint_shiftright128(m5[1], m5[2], 8);
+	  RES->bitsu64[2] = oriint_shiftright128(m5[2], m5[3], 8);
+	  RES->bitsu64[3] = oriint_shiftright128(m5[3], m5[4], 8);
+
+	  cc = oriint_addcarry_u64(0, RES->bitsu64[0], r512[4], RES->bitsu64 + 0);
+	  cc = oriint_addcarry_u64(cc, RES->bitsu64[1], r512[5], RES->bitsu64 + 1);
+	  cc = oriint_addcarry_u64(cc, RES->bitsu64[2], r512[6], RES->bitsu64 + 2);
+	  cc = oriint_addcarry_u64(cc, RES->bitsu64[3], r512[7], RES->bitsu64 + 3);
+	  RES->bitsu64[4] = cc;
+	  cc = oriint_addcarry_u64(0, RES->bitsu64[0], c, RES->bitsu64 + 0);
+	  cc = oriint_addcarry_u64(cc, RES->bitsu64[1], 0ULL, RES->bitsu64 + 1);
+	  cc = oriint_addcarry_u64(cc, RES->bitsu64[2], 0ULL, RES->bitsu64 + 2);
+	  cc = oriint_addcarry_u64(cc, RES->bitsu64[3], 0ULL, RES->bitsu64 + 3);
+	  RES->bitsu64[4] += cc;
+
+	  // Here RES < 2^256 + 5*2^248 + 1
+	  oriint_fold_p(RES);
+}
+
+static inline void oriint_montmul(oriint_t *RES, const oriint_t *a, const oriint_t *b) {
+	  uint64_t r512[8];
+
+	  oriint_mul_512(r512, a->bitsu64, b->bitsu64);
+	  oriint_redc_512(RES, r512);
+}
+
+static inline void oriint_modmul(oriint_t *RES, oriint_t *a) {
+	  uint64_t r512[8];
+
+	  oriint_mul_512(r512, RES->bitsu64, a->bitsu64);
+	  oriint_reduce_512(RES, r512);
+}
+
+static inline void oriint_modsqr(oriint_t *RES) {
+	  uint64_t r512[8];
+
+	  oriint_sqr_512(r512, RES->bitsu64);
+	  oriint_reduce_512(RES, r512);
+}
+
+static inline void oriint_montsqr(oriint_t *RES, const oriint_t *a) {
+	  uint64_t r512[8];
+
+	  oriint_sqr_512(r512, a->bitsu64);
+	  oriint_redc_512(RES, r512);
+}
+
+// Double-width accumulation, for sums of products that go through a single
+// oriint_redc_512. Arithmetic is mod 2^512: a difference may wrap as long
+// as the final sum is in [0, 2^512).
+
+// r512 += a
+static inline void oriint_add_512(uint64_t *r512, const uint64_t *a) {
+	  uint64_t c;
 
-	  // Reduce from 512 to 320 
-	  oriint_imm_umul(r512 + 4, 0x1000003D1ULL, t);
-	  c = oriint_addcarry_u64(0, r512[0], t[0], r512 + 0);
-	  c = oriint_addcarry_u64(c, r512[1], t[1], r512 + 1);
-	  c = oriint_addcarry_u64(c, r512[2], t[2], r512 + 2);
-	  c = oriint_addcarry_u64(c, r512[3], t[3], r512 + 3);
+	  c = oriint_addcarry_u64(0, r512[0], a[0], r512 + 0);
+	  c = oriint_addcarry_u64(c, r512[1], a[1], r512 + 1);
+	  c = oriint_addcarry_u64(c, r512[2], a[2], r512 + 2);
+	  c = oriint_addcarry_u64(c, r512[3], a[3], r512 + 3);
+	  c = oriint_addcarry_u64(c, r512[4], a[4], r512 + 4);
+	  c = oriint_addcarry_u64(c, r512[5], a[5], r512 + 5);
+	  c = oriint_addcarry_u64(c, r512[6], a[6], r512 + 6);
+	  oriint_addcarry_u64(c, r512[7], a[7], r512 + 7);
+}
 
-	  // Reduce from 320 to 256 
-	  // No overflow possible here t[4]+c<=0x1000003D1ULL
-	  al = oriint_umul128(t[4] + c, 0x1000003D1ULL, &ah); 
-	  c = oriint_addcarry_u64(0, r512[0], al, RES->bitsu64 + 0);
-	  c = oriint_addcarry_u64(c, r512[1], ah, RES->bitsu64 + 1);
-	  c = oriint_addcarry_u64(c, r512[2], 0ULL, RES->bitsu64 + 2);
-	  c = oriint_addcarry_u64(c, r512[3], 0ULL, RES->bitsu64 + 3);
+// r512 -= a
+static inline void oriint_sub_512(uint64_t *r512, const uint64_t *a) {
+	  uint64_t c;
+
+	  c = oriint_subborrow_u64(0, r512[0], a[0], r512 + 0);
+	  c = oriint_subborrow_u64(c, r512[1], a[1], r512 + 1);
+	  c = oriint_subborrow_u64(c, r512[2], a[2], r512 + 2);
+	  c = oriint_subborrow_u64(c, r512[3], a[3], r512 + 3);
+	  c = oriint_subborrow_u64(c, r512[4], a[4], r512 + 4);
+	  c = oriint_subborrow_u64(c, r512[5], a[5], r512 + 5);
+	  c = oriint_subborrow_u64(c, r512[6], a[6], r512 + 6);
+	  oriint_subborrow_u64(c, r512[7], a[7], r512 + 7);
+}
 
-	  // Probability of carry here or that this>P is very very unlikely
-	  RES->bitsu64[4] = 0ULL; 
+// r512 += a * 2^256 for a < 2^256; with a = kP this pads a difference
+// without changing its residue
+static inline void oriint_add_512_hi(uint64_t *r512, const oriint_t *a) {
+	  uint64_t c;
 
+	  c = oriint_addcarry_u64(0, r512[4], a->bitsu64[0], r512 + 4);
+	  c = oriint_addcarry_u64(c, r512[5], a->bitsu64[1], r512 + 5);
+	  c = oriint_addcarry_u64(c, r512[6], a->bitsu64[2], r512 + 6);
+	  oriint_addcarry_u64(c, r512[7], a->bitsu64[3], r512 + 7);
 }
 
 static inline void oriint_modsub_2(oriint_t *RES, oriint_t *a, oriint_t *b) {
@@ -326,203 +727,584 @@ static inline void oriint_modadd(oriint_t *RES, oriint_t *a, oriint_t *b) {
 		    oriint_set(RES, &p);
 }
 
+// Constant-time inversion by Bernstein-Yang divsteps (safegcd). Values are
+// held in signed 62-bit limbs in the bits64 view of oriint_t; P itself is
+// the sparse {-1, 0, 0, 0, 5} since P = 5*2^248 - 1, and P^-1 == -1 mod 2^62.
+// For 251-bit inputs 726 divsteps always suffice, so 12 batches of 62 are
+// run unconditionally.
+#define ORIINT_DIVSTEP_BATCHES 12
+
+// 62 divsteps on the low bits of f and g, returning the transition matrix
+// scaled by 2^62. Branch-free in delta, f and g.
+static inline int64_t oriint_divsteps_62(int64_t delta, uint64_t f, uint64_t g, oriint_trans_t *t) {
+    uint64_t u = 1, v = 0, q = 0, r = 1;
+    uint64_t c1, c2, x;
+
+    for (int i = 0; i < 62; i++) {
+        c2 = -(g & 1);
+        c1 = (uint64_t)((-delta) >> 63) & c2;
+
+        // if delta > 0 and g odd: (f, g, u, v, q, r) = (g, -f, q, r, -u, -v)
+        x = (f ^ g) & c1; f ^= x; g ^= x; g = (g ^ c1) - c1;
+        x = (u ^ q) & c1; u ^= x; q ^= x; q = (q ^ c1) - c1;
+        x = (v ^ r) & c1; v ^= x; r ^= x; r = (r ^ c1) - c1;
+        delta = (delta ^ (int64_t)c1) - (int64_t)c1;
+
+        // if g odd: g += f
+        g += f & c2;
+        q += u & c2;
+        r += v & c2;
+
+        delta++;
+        g >>= 1;
+        u <<= 1;
+        v <<= 1;
+    }
+    t->u = (int64_t)u;
+    t->v = (int64_t)v;
+    t->q = (int64_t)q;
+    t->r = (int64_t)r;
+    return delta;
+}
+
+// [d, e] = (t * [d, e] + P * [md, me]) / 2^62, keeping d, e in (-2P, P)
+static inline void oriint_update_de_62(oriint_t *d, oriint_t *e, const oriint_trans_t *t) {
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    int64_t md, me, sd, se;
+    __int128 cd, ce;
+
+    sd = d->bits64[4] >> 63;
+    se = e->bits64[4] >> 63;
+    md = (u & sd) + (v & se);
+    me = (q & sd) + (r & se);
+
+    cd = (__int128)u * d->bits64[0] + (__int128)v * e->bits64[0];
+    ce = (__int128)q * d->bits64[0] + (__int128)r * e->bits64[0];
+
+    // P^-1 == -1 (mod 2^62): choose md, me so the low 62 bits cancel
+    md -= (md - (int64_t)cd) & (int64_t)MSK62;
+    me -= (me - (int64_t)ce) & (int64_t)MSK62;
+
+    cd -= md;
+    ce -= me;
+    cd >>= 62;
+    ce >>= 62;
+
+    for (int i = 1; i < 4; i++) {
+        cd += (__int128)u * d->bits64[i] + (__int128)v * e->bits64[i];
+        ce += (__int128)q * d->bits64[i] + (__int128)r * e->bits64[i];
+        d->bits64[i - 1] = (int64_t)cd & (int64_t)MSK62; cd >>= 62;
+        e->bits64[i - 1] = (int64_t)ce & (int64_t)MSK62; ce >>= 62;
+    }
+
+    cd += (__int128)u * d->bits64[4] + (__int128)v * e->bits64[4] + (__int128)5 * md;
+    ce += (__int128)q * d->bits64[4] + (__int128)r * e->bits64[4] + (__int128)5 * me;
+    d->bits64[3] = (int64_t)cd & (int64_t)MSK62; cd >>= 62;
+    e->bits64[3] = (int64_t)ce & (int64_t)MSK62; ce >>= 62;
+    d->bits64[4] = (int64_t)cd;
+    e->bits64[4] = (int64_t)ce;
+}
+
+// [f, g] = t * [f, g] / 2^62
+static inline void oriint_update_fg_62(oriint_t *f, oriint_t *g, const oriint_trans_t *t) {
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    __int128 cf, cg;
+
+    cf = (__int128)u * f->bits64[0] + (__int128)v * g->bits64[0];
+    cg = (__int128)q * f->bits64[0] + (__int128)r * g->bits64[0];
+    cf >>= 62;
+    cg >>= 62;
+
+    for (int i = 1; i < NBLOCK; i++) {
+        cf += (__int128)u * f->bits64[i] + (__int128)v * g->bits64[i];
+        cg += (__int128)q * f->bits64[i] + (__int128)r * g->bits64[i];
+        f->bits64[i - 1] = (int64_t)cf & (int64_t)MSK62; cf >>= 62;
+        g->bits64[i - 1] = (int64_t)cg & (int64_t)MSK62; cg >>= 62;
+    }
+    f->bits64[4] = (int64_t)cf;
+    g->bits64[4] = (int64_t)cg;
+}
+
+static inline void oriint_to_signed62(oriint_t *RES, const oriint_t *a) {
+    uint64_t a0 = a->bitsu64[0], a1 = a->bitsu64[1], a2 = a->bitsu64[2], a3 = a->bitsu64[3];
+
+    RES->bitsu64[0] = a0 & MSK62;
+    RES->bitsu64[1] = ((a0 >> 62) | (a1 << 2)) & MSK62;
+    RES->bitsu64[2] = ((a1 >> 60) | (a2 << 4)) & MSK62;
+    RES->bitsu64[3] = ((a2 >> 58) | (a3 << 6)) & MSK62;
+    RES->bitsu64[4] = a3 >> 56;
+}
+
+static inline void oriint_from_signed62(oriint_t *RES, const oriint_t *a) {
+    uint64_t a0 = a->bitsu64[0], a1 = a->bitsu64[1], a2 = a->bitsu64[2], a3 = a->bitsu64[3], a4 = a->bitsu64[4];
+
+    RES->bitsu64[0] = a0 | (a1 << 62);
+    RES->bitsu64[1] = (a1 >> 2) | (a2 << 60);
+    RES->bitsu64[2] = (a2 >> 4) | (a3 << 58);
+    RES->bitsu64[3] = (a3 >> 6) | (a4 << 56);
+    RES->bitsu64[4] = 0ULL;
+}
+
+// d in (-2P, P) to [0, P), negated first when sign < 0
+static inline void oriint_normalize_62(oriint_t *d, int64_t sign) {
+    int64_t r0 = d->bits64[0], r1 = d->bits64[1], r2 = d->bits64[2], r3 = d->bits64[3], r4 = d->bits64[4];
+    int64_t cond_add, cond_negate;
+    const int64_t M62 = (int64_t)MSK62;
+
+    cond_add = r4 >> 63;
+    r0 += -1 & cond_add;
+    r4 += 5 & cond_add;
+    cond_negate = sign >> 63;
+    r0 = (r0 ^ cond_negate) - cond_negate;
+    r1 = (r1 ^ cond_negate) - cond_negate;
+    r2 = (r2 ^ cond_negate) - cond_negate;
+    r3 = (r3 ^ cond_negate) - cond_negate;
+    r4 = (r4 ^ cond_negate) - cond_negate;
+    r1 += r0 >> 62; r0 &= M62;
+    r2 += r1 >> 62; r1 &= M62;
+    r3 += r2 >> 62; r2 &= M62;
+    r4 += r3 >> 62; r3 &= M62;
+
+    cond_add = r4 >> 63;
+    r0 += -1 & cond_add;
+    r4 += 5 & cond_add;
+    r1 += r0 >> 62; r0 &= M62;
+    r2 += r1 >> 62; r1 &= M62;
+    r3 += r2 >> 62; r2 &= M62;
+    r4 += r3 >> 62; r3 &= M62;
+
+    d->bits64[0] = r0;
+    d->bits64[1] = r1;
+    d->bits64[2] = r2;
+    d->bits64[3] = r3;
+    d->bits64[4] = r4;
+}
+
+// RES = RES^-1 mod P (0 stays 0). Constant time.
 static inline void oriint_modinv(oriint_t *RES) {
-  	oriint_t u;
-	  oriint_t v;
-	  oriint_t r;
-	  oriint_t s;
-
-	  #define SWAP_ADD(x,y) x+=y;y-=x;
-	  #define SWAP_SUB(x,y) x-=y;y+=x;
-	  #define IS_EVEN(x) ((x&1)==0)
-	  #define IS_ONE(x) ((x.bitsu64[0] == 1ULL)&&(x.bitsu64[1] == 0ULL)&&(x.bitsu64[2] == 0ULL)&&(x.bitsu64[3] == 0ULL)&&(x.bitsu64[4] == 0ULL))
-	  #define IS_NEGATIVE(x) (x.bits64[4] < 0LL)
-	  #define IS_POSITIVE(x) (x.bits64[4] >= 0LL)
-
-	  oriint_t r0_P;
-	  oriint_t s0_P;
-	  oriint_t uu_u;
-	  oriint_t uv_v;
-	  oriint_t vu_u;
-	  oriint_t vv_v;
-	  oriint_t uu_r;
-	  oriint_t uv_s;
-	  oriint_t vu_r;
-	  oriint_t vv_s;
-	  oriint_t checkGE;
-	  int64_t bitCount;
-	  int64_t uu, uv, vu, vv;
-	  int64_t v0, u0;
-	  int64_t nb0;
-
-	  oriint_set(&u,&P);
-	  oriint_set(&v,RES);
-	  oriint_clear(&r);
-	  oriint_set_one(&s);
-	  while (!oriint_is_zero(&u)) {
-		    uu = 1; uv = 0;
-		    vu = 0; vv = 1;
-		    u0 = u.bits64[0];
-		    v0 = v.bits64[0];
-		    bitCount = 0;
-		    while (true) {
-			      while (IS_EVEN(u0) && bitCount<62) {
-				        bitCount++;
-				        u0 >>= 1;
-				        vu <<= 1;
-				        vv <<= 1;
-			      }
-			      if (bitCount == 62)
-				        break;
-			      nb0 = (v0 + u0) & 0x3;
-			      if (nb0 == 0) {
-				        SWAP_ADD(uv, vv);
-				        SWAP_ADD(uu, vu);
-				        SWAP_ADD(u0, v0);
-			      } else {
-				        SWAP_SUB(uv, vv);
-				        SWAP_SUB(uu, vu);
-				        SWAP_SUB(u0, v0);
-			      }
-		    }
-		    oriint_imult(&uu_u,&u,uu);
-		    oriint_imult(&uv_v,&v,uv);
-		    oriint_imult(&vu_u,&u,vu);
-		    oriint_imult(&vv_v,&v,vv);
-		    oriint_imult(&uu_r,&r,uu);
-		    oriint_imult(&uv_s,&s,uv);
-		    oriint_imult(&vu_r,&r,vu);
-		    oriint_imult(&vv_s,&s,vv);
-		    uint64_t r0 = ((uu_r.bitsu64[0] + uv_s.bitsu64[0]) * MM64) & MSK62;
-		    uint64_t s0 = ((vu_r.bitsu64[0] + vv_s.bitsu64[0]) * MM64) & MSK62;
-		    oriint_mult(&r0_P,&P,r0);
-		    oriint_mult(&s0_P,&P,s0);
-		    oriint_add_3(&u,&uu_u,&uv_v);
-		    oriint_add_3(&v,&vu_u,&vv_v);
-		    oriint_add_3(&r,&uu_r,&uv_s);
-		    oriint_add_1(&r,&r0_P);
-		    oriint_add_3(&s,&vu_r,&vv_s);
-		    oriint_add_1(&s,&s0_P);
-		    oriint_shiftr(62, &u);
-		    oriint_shiftr(62, &v);
-		    oriint_shiftr(62, &r);
-		    oriint_shiftr(62, &s);
-	  }
-	  if (IS_NEGATIVE(v)) {
-		    oriint_neg(&v);
-		    oriint_neg(&s);
-		    oriint_add_1(&s,&P);
-	  }
-	  if (!IS_ONE(v)) {
-		    oriint_clear(RES);
-		    return;
-	  }
-	  if (IS_NEGATIVE(s))
-	      oriint_add_1(&s,&P);
-	  oriint_sub_3(&checkGE, &s, &P);
-	  if (IS_POSITIVE(checkGE))
-		    oriint_sub_2(&s,&P);
-	  oriint_set(RES, &s);
+    oriint_t d, e, f, g;
+    oriint_trans_t t;
+    int64_t delta = 1;
+
+    oriint_fold_p(RES);
+    oriint_clear(&d);
+    oriint_set_one(&e);
+    f.bits64[0] = -1; f.bits64[1] = 0; f.bits64[2] = 0; f.bits64[3] = 0; f.bits64[4] = 5;
+    oriint_to_signed62(&g, RES);
+
+    for (int i = 0; i < ORIINT_DIVSTEP_BATCHES; i++) {
+        delta = oriint_divsteps_62(delta, f.bitsu64[0], g.bitsu64[0], &t);
+        oriint_update_de_62(&d, &e, &t);
+        oriint_update_fg_62(&f, &g, &t);
+    }
+
+    // g is now 0 and f = +-1, so d = +-RES^-1
+    oriint_normalize_62(&d, f.bits64[4]);
+    oriint_from_signed62(RES, &d);
 }
 
-static void oriint_modexp_ct(oriint_t *RES, const oriint_t *a, const oriint_t *exp) {
+// Variable-time divsteps for public inputs: runs of zeros in g are skipped
+// with one ctz and up to 6 bits of g are cancelled per odd step. eta = -delta.
+static inline int64_t oriint_divsteps_62_vartime(int64_t eta, uint64_t f, uint64_t g, oriint_trans_t *t) {
+    uint64_t u = 1, v = 0, q = 0, r = 1;
+    uint64_t m, w, x;
+    int i = 62, limit, zeros;
+
+    for (;;) {
+        // Sentinel bit: count zeros only up to i
+        zeros = __builtin_ctzll(g | (UINT64_MAX << i));
+        g >>= zeros;
+        u <<= zeros;
+        v <<= zeros;
+        eta -= zeros;
+        i -= zeros;
+        if (i == 0)
+            break;
+
+        if (eta < 0) {
+            eta = -eta;
+            x = f; f = g; g = -x;
+            x = u; u = q; q = -x;
+            x = v; v = r; r = -x;
+            limit = ((int)eta + 1) > i ? i : ((int)eta + 1);
+            m = (UINT64_MAX >> (64 - limit)) & 63U;
+            w = (f * g * (f * f - 2)) & m;
+        } else {
+            limit = ((int)eta + 1) > i ? i : ((int)eta + 1);
+            m = (UINT64_MAX >> (64 - limit)) & 15U;
+            w = f + (((f + 1) & 4) << 1);
+            w = (-w * g) & m;
+        }
+        g += f * w;
+        q += u * w;
+        r += v * w;
+    }
+    t->u = (int64_t)u;
+    t->v = (int64_t)v;
+    t->q = (int64_t)q;
+    t->r = (int64_t)r;
+    return eta;
+}
+
+// [f, g] = t * [f, g] / 2^62 on the low len limbs
+static inline void oriint_update_fg_62_vartime(int len, oriint_t *f, oriint_t *g, const oriint_trans_t *t) {
+    const int64_t u = t->u, v = t->v, q = t->q, r = t->r;
+    __int128 cf, cg;
+
+    cf = (__int128)u * f->bits64[0] + (__int128)v * g->bits64[0];
+    cg = (__int128)q * f->bits64[0] + (__int128)r * g->bits64[0];
+    cf >>= 62;
+    cg >>= 62;
+
+    for (int i = 1; i < len; i++) {
+        cf += (__int128)u * f->bits64[i] + (__int128)v * g->bits64[i];
+        cg += (__int128)q * f->bits64[i] + (__int128)r * g->bits64[i];
+        f->bits64[i - 1] = (int64_t)cf & (int64_t)MSK62; cf >>= 62;
+        g->bits64[i - 1] = (int64_t)cg & (int64_t)MSK62; cg >>= 62;
+    }
+    f->bits64[len - 1] = (int64_t)cf;
+    g->bits64[len - 1] = (int64_t)cg;
+}
+
+// RES = RES^-1 mod P for public RES only: stops as soon as g reaches 0 and
+// drops limbs as f and g shrink.
+static inline void oriint_modinv_vartime(oriint_t *RES) {
+    oriint_t d, e, f, g;
+    oriint_trans_t t;
+    int64_t eta = -1;
+    int64_t cond, fn, gn;
+    int len = NBLOCK;
+
+    oriint_fold_p(RES);
+    oriint_clear(&d);
+    oriint_set_one(&e);
+    f.bits64[0] = -1; f.bits64[1] = 0; f.bits64[2] = 0; f.bits64[3] = 0; f.bits64[4] = 5;
+    oriint_to_signed62(&g, RES);
+
+    while (true) {
+        eta = oriint_divsteps_62_vartime(eta, f.bitsu64[0], g.bitsu64[0], &t);
+        oriint_update_de_62(&d, &e, &t);
+        oriint_update_fg_62_vartime(len, &f, &g, &t);
+
+        if (g.bits64[0] == 0) {
+            cond = 0;
+            for (int j = 1; j < len; j++)
+                cond |= g.bits64[j];
+            if (cond == 0)
+                break;
+        }
+
+        // Drop the top limb once both f and g fit in one fewer
+        fn = f.bits64[len - 1];
+        gn = g.bits64[len - 1];
+        cond = ((int64_t)len - 2) >> 63;
+        cond |= fn ^ (fn >> 63);
+        cond |= gn ^ (gn >> 63);
+        if (cond == 0) {
+            f.bitsu64[len - 2] |= (uint64_t)fn << 62;
+            g.bitsu64[len - 2] |= (uint64_t)gn << 62;
+            len--;
+        }
+    }
+
+    // Restore the full-width sign of f for the normalization
+    oriint_normalize_62(&d, f.bits64[len - 1]);
+    oriint_from_signed62(RES, &d);
+}
+
+#define ORIINT_EXP_WINDOW 4
+#define ORIINT_EXP_BITS (NBLOCK * 64)   // every bit of exp
+
+static inline void oriint_modsqr_n(oriint_t *RES, int n) {
+    for (int i = 0; i < n; i++)
+        oriint_modsqr(RES);
+}
+
+// Fixed 4-bit window over all ORIINT_EXP_BITS bits of exp. Every window
+// reads all 16 table entries, so neither the branch pattern nor the memory
+// access pattern depends on exp: 320 squarings and 80 multiplies, against
+// 320 and 320 for the bit-by-bit ladder.
+static inline void oriint_modexp_ct(oriint_t *RES, const oriint_t *a, const oriint_t *exp) {
+    oriint_t table[1 << ORIINT_EXP_WINDOW];
     oriint_t result;
-    oriint_t base;
-    oriint_t tmp;
+    oriint_t t;
+
+    oriint_set_one(&table[0]);
+    oriint_set(&table[1], a);
+    for (int j = 2; j < (1 << ORIINT_EXP_WINDOW); j++) {
+        oriint_set(&table[j], &table[j - 1]);
+        oriint_modmul(&table[j], &table[1]);
+    }
 
-    oriint_set(&base, a);
     oriint_set_one(&result);
+    for (int i = ORIINT_EXP_BITS - ORIINT_EXP_WINDOW; i >= 0; i -= ORIINT_EXP_WINDOW) {
+        uint64_t w = (exp->bitsu64[i >> 6] >> (i & 63)) & ((1ULL << ORIINT_EXP_WINDOW) - 1);
+
+        oriint_modsqr_n(&result, ORIINT_EXP_WINDOW);
+
+        oriint_clear(&t);
+        for (uint64_t j = 0; j < (1 << ORIINT_EXP_WINDOW); j++) {
+            uint64_t d = j ^ w;
+            uint64_t mask = ((d | (0 - d)) >> 63) - 1;
+            oriint_select_mask(&t, &t, &table[j], mask);
+        }
+        oriint_modmul(&result, &t);
+    }
 
-    for (int i = NBLOCK * 64 - 1; i >= 0; i--)
-    {
-        // result = result^2
-        oriint_set(&tmp, &result);
-        oriint_modmul(&tmp, &result);
+    oriint_set(RES, &result);
+}
 
-        // result = bit ? tmp * base : tmp
-        uint64_t word = i >> 6;
-        uint64_t bit  = (exp->bitsu64[word] >> (i & 63)) & 1ULL;
-        uint64_t mask = -(int64_t)bit;
+// Left-to-right square and multiply over the significant bits of exp only.
+// For public base and exponent.
+static inline void oriint_modexp_vartime(oriint_t *RES, const oriint_t *a, const oriint_t *exp) {
+    oriint_t result;
+    oriint_t base;
+    int top = NBLOCK * 64 - 1;
 
-        oriint_t mulres;
-        oriint_set(&mulres, &tmp);
-        oriint_modmul(&mulres, &base);
+    oriint_set(&base, a);
+    oriint_set_one(&result);
 
-        oriint_select_mask(&result, &tmp, &mulres, mask);
+    while (top >= 0 && ((exp->bitsu64[top >> 6] >> (top & 63)) & 1ULL) == 0)
+        top--;
+
+    for (int i = top; i >= 0; i--) {
+        oriint_modsqr(&result);
+        if ((exp->bitsu64[i >> 6] >> (i & 63)) & 1ULL)
+            oriint_modmul(&result, &base);
     }
 
     oriint_set(RES, &result);
 }
 
-static void oriint_compute_sqrt_exp(oriint_t *e) {
-    oriint_set(e, &P);
+// Addition chains for P = 5*2^248 - 1. x_k below is a^(2^k - 1).
 
-    oriint_t one;
-    oriint_set_one(&one);
-    oriint_add_1(e, &one);
+// RES = a^((P+1)/4) = a^(5*2^246): 248 squarings, 1 multiply
+static inline void oriint_modpow_sqrt(oriint_t *RES, const oriint_t *a) {
+    oriint_t base;
+    oriint_t r;
 
-    oriint_shiftr(2, e);
+    oriint_set(&base, a);
+    oriint_set(&r, a);
+    oriint_modsqr_n(&r, 2);
+    oriint_modmul(&r, &base);
+    oriint_modsqr_n(&r, 246);
+    oriint_set(RES, &r);
 }
 
-static bool oriint_modsqrt(oriint_t *RES, const oriint_t *a) {
-    oriint_t exp;
-    oriint_compute_sqrt_exp(&exp);
+// RES = RES^(P-2) = RES^-1, using P - 2 = 5*(2^248 - 1) + 2:
+// 249 squarings, 13 multiplies. Constant time; 0 stays 0.
+static inline void oriint_modinv_fermat(oriint_t *RES) {
+    oriint_t a2, x2, x3, x6, x12, x24, x48, x96, x192, x240, x246, x248, r;
+
+    oriint_set(&a2, RES);
+    oriint_modsqr(&a2);
+    oriint_set(&x2, &a2);
+    oriint_modmul(&x2, RES);
+    oriint_set(&x3, &x2);
+    oriint_modsqr(&x3);
+    oriint_modmul(&x3, RES);
+    oriint_set(&x6, &x3);
+    oriint_modsqr_n(&x6, 3);
+    oriint_modmul(&x6, &x3);
+    oriint_set(&x12, &x6);
+    oriint_modsqr_n(&x12, 6);
+    oriint_modmul(&x12, &x6);
+    oriint_set(&x24, &x12);
+    oriint_modsqr_n(&x24, 12);
+    oriint_modmul(&x24, &x12);
+    oriint_set(&x48, &x24);
+    oriint_modsqr_n(&x48, 24);
+    oriint_modmul(&x48, &x24);
+    oriint_set(&x96, &x48);
+    oriint_modsqr_n(&x96, 48);
+    oriint_modmul(&x96, &x48);
+    oriint_set(&x192, &x96);
+    oriint_modsqr_n(&x192, 96);
+    oriint_modmul(&x192, &x96);
+    oriint_set(&x240, &x192);
+    oriint_modsqr_n(&x240, 48);
+    oriint_modmul(&x240, &x48);
+    oriint_set(&x246, &x240);
+    oriint_modsqr_n(&x246, 6);
+    oriint_modmul(&x246, &x6);
+    oriint_set(&x248, &x246);
+    oriint_modsqr_n(&x248, 2);
+    oriint_modmul(&x248, &x2);
+
+    // x248^5 * a^2
+    oriint_set(&r, &x248);
+    oriint_modsqr_n(&r, 2);
+    oriint_modmul(&r, &x248);
+    oriint_modmul(&r, &a2);
+    oriint_set(RES, &r);
+}
 
-    oriint_modexp_ct(RES, a, &exp);
+static inline bool oriint_modsqrt(oriint_t *RES, const oriint_t *a) {
+    oriint_t ra;
+    oriint_set(&ra, a);
+    oriint_fold_p(&ra);
+
+    oriint_modpow_sqrt(RES, &ra);
 
     // verify sqrt
     oriint_t check;
     oriint_set(&check, RES);
-    oriint_modmul(&check, RES);
+    oriint_modsqr(&check);
 
-    if (!oriint_is_equal(&check, a))
+    if (!oriint_is_equal(&check, &ra))
         return false;
 
     return true;
 }
 
-static inline int oriint_getsize() {
-    int i=(2*NBLOCK)-1;
-    while(i>0 && P.bitsu32[i]==0) i--;
-    return i+1;
+#define ORIINT_JACOBI_INNER 29   // low 31 bits exact, 3 still exact at the last step
+// The binary GCD of a < P and P ends within 2 * 251 - 1 = 501 steps (each
+// step drops a bit from len(a) + len(b)), 18 outer rounds of 29; P - 1 and
+// 2^243 take all 18. Two more rounds are margin.
+#define ORIINT_JACOBI_OUTER 20
+
+// Binary GCD steps on 64-bit approximations xa, xb of a, b (top 33 bits and
+// exact low 31 bits), Jacobi sign tracked in bit 0 of *ls. f0, g0, f1, g1
+// give 2^29 a' = f0 a + g0 b and 2^29 b' = f1 a + g1 b. Constant time.
+static inline void oriint_jacobi_inner(uint64_t xa, uint64_t xb, int64_t *f0, int64_t *g0, int64_t *f1, int64_t *g1, uint64_t *ls) {
+    uint64_t u0 = 1, v0 = 0, u1 = 0, v1 = 1;
+    uint64_t odd, swap, t, j = *ls;
+
+    for (int i = 0; i < ORIINT_JACOBI_INNER; i++) {
+        odd = -(xa & 1);
+        swap = odd & -(uint64_t)(xa < xb);
+        // swapping two odd values: quadratic reciprocity
+        j ^= (xa & xb & swap) >> 1;
+        t = (xa ^ xb) & swap; xa ^= t; xb ^= t;
+        t = (u0 ^ u1) & swap; u0 ^= t; u1 ^= t;
+        t = (v0 ^ v1) & swap; v0 ^= t; v1 ^= t;
+        xa -= xb & odd;
+        u0 -= u1 & odd;
+        v0 -= v1 & odd;
+        // halving: (2 / b) = -1 when b = 3, 5 mod 8
+        xa >>= 1;
+        u1 <<= 1;
+        v1 <<= 1;
+        j ^= (xb >> 1) ^ (xb >> 2);
+    }
+
+    *f0 = (int64_t)u0; *g0 = (int64_t)v0;
+    *f1 = (int64_t)u1; *g1 = (int64_t)v1;
+    *ls = j;
+}
+
+// RES = |f a + g b| / 2^29, returns all-ones if the value was negative
+static inline uint64_t oriint_jacobi_update(uint64_t RES[4], const uint64_t a[4], const uint64_t b[4], int64_t f, int64_t g) {
+    uint64_t r[5], neg, c;
+    __int128 acc = 0;
+
+    for (int i = 0; i < 4; i++) {
+        acc += (__int128)f * (__int128)a[i] + (__int128)g * (__int128)b[i];
+        r[i] = (uint64_t)acc;
+        acc >>= 64;
+    }
+    r[4] = (uint64_t)acc;
+
+    for (int i = 0; i < 4; i++)
+        r[i] = (r[i] >> ORIINT_JACOBI_INNER) | (r[i + 1] << (64 - ORIINT_JACOBI_INNER));
+    neg = -(r[4] >> 63);
+
+    c = neg & 1;
+    for (int i = 0; i < 4; i++) {
+        r[i] = (r[i] ^ neg) + c;
+        c = r[i] < c;
+        RES[i] = r[i];
+    }
+    return neg;
+}
+
+// 64-bit approximations of a and b: exact when both fit in 64 bits,
+// else the top 33 bits of max(len(a), len(b)) and the low 31 bits
+static inline void oriint_jacobi_approx(uint64_t *xa, uint64_t *xb, const uint64_t a[4], const uint64_t b[4]) {
+    const uint64_t M31 = (1ULL << 31) - 1;
+    uint64_t ah = a[1], al = a[0], bh = b[1], bl = b[0];
+    uint64_t m, s, ta, tb, big;
+
+    for (int i = 2; i < 4; i++) {
+        m = a[i] | b[i];
+        m = -((m | (0 - m)) >> 63);
+        ah ^= (ah ^ a[i]) & m;      al ^= (al ^ a[i - 1]) & m;
+        bh ^= (bh ^ b[i]) & m;      bl ^= (bl ^ b[i - 1]) & m;
+    }
+
+    s = (uint64_t)__builtin_clzll(ah | bh | 1);
+    ta = (ah << s) | ((al >> 1) >> (63 - s));
+    tb = (bh << s) | ((bl >> 1) >> (63 - s));
+
+    big = a[1] | b[1] | a[2] | b[2] | a[3] | b[3];
+    big = -((big | (0 - big)) >> 63);
+    *xa = (a[0] & ~big) | (((a[0] & M31) | (ta & ~M31)) & big);
+    *xb = (b[0] & ~big) | (((b[0] & M31) | (tb & ~M31)) & big);
 }
 
-static void oriint_setup_mm64_msize() {
-    uint64_t _mm64;
-    int _msize;
+// Legendre symbol (a / P) in {1, -1, 0}, constant time. Pornin's binary
+// GCD with approximations: 29 steps at a time run on 64-bit words and are
+// then applied to the full values, so it costs a fraction of a^((P-1)/2).
+static inline int oriint_legendre(const oriint_t *a) {
+    uint64_t x[4], y[4], nx[4], ny[4];
+    uint64_t xa, xb, ls = 0, nega, nz;
+    int64_t f0, g0, f1, g1;
+    oriint_t t;
+
+    oriint_set(&t, a);
+    oriint_fold_p(&t);
+    for (int i = 0; i < 4; i++) {
+        x[i] = t.bitsu64[i];
+        y[i] = P.bitsu64[i];
+    }
 
-    int nSize = oriint_getsize();
-    // Last digit inversions (Newton's iteration)
-    {
-        int64_t x, t;
-        x = t = P.bits64[0];
-        x = x * (2 - t * x);
-        x = x * (2 - t * x);
-        x = x * (2 - t * x);
-        x = x * (2 - t * x);
-        x = x * (2 - t * x);
-        _mm64 = (uint64_t)(-x);
+    for (int it = 0; it < ORIINT_JACOBI_OUTER; it++) {
+        oriint_jacobi_approx(&xa, &xb, x, y);
+        oriint_jacobi_inner(xa, xb, &f0, &g0, &f1, &g1, &ls);
+        nega = oriint_jacobi_update(nx, x, y, f0, g0);
+        oriint_jacobi_update(ny, x, y, f1, g1);
+        // (-a / b) = (-1 / b) (a / b)
+        ls ^= nega & (ny[0] >> 1);
+        for (int i = 0; i < 4; i++) {
+            x[i] = nx[i];
+            y[i] = ny[i];
+        }
     }
-    // Size of Montgomery mult (64bits digit)
-    _msize = nSize/2;
 
-    // Menampilkan MM64 dan MSize
-    printf("DEBUG - MM64  : %016llx\n", _mm64);
-    printf("DEBUG - MSize : %d\n", _msize);
+    // y = gcd(a, P): 1 unless a == 0 mod P
+    nz = (y[0] ^ 1) | y[1] | y[2] | y[3];
+    nz = -((nz | (0 - nz)) >> 63);
+    return (int)((1 - 2 * (int64_t)(ls & 1)) & ~(int64_t)nz);
 }
 
-static inline void oriint_setup_r2() {
-    oriint_t one, r, _r2;
+// Legendre symbol for public a: same steps, stops once a reaches 0
+static inline int oriint_legendre_vartime(const oriint_t *a) {
+    uint64_t x[4], y[4], nx[4], ny[4];
+    uint64_t xa, xb, ls = 0, nega;
+    int64_t f0, g0, f1, g1;
+    oriint_t t;
+
+    oriint_set(&t, a);
+    oriint_fold_p(&t);
+    for (int i = 0; i < 4; i++) {
+        x[i] = t.bitsu64[i];
+        y[i] = P.bitsu64[i];
+    }
 
-    oriint_set_one(&one);
-    oriint_montgomerymult(&r, &one, &one);
-    oriint_montgomerymult(&_r2, &r, &one);
-    oriint_modinv(&_r2);
+    while (x[0] | x[1] | x[2] | x[3]) {
+        oriint_jacobi_approx(&xa, &xb, x, y);
+        oriint_jacobi_inner(xa, xb, &f0, &g0, &f1, &g1, &ls);
+        nega = oriint_jacobi_update(nx, x, y, f0, g0);
+        oriint_jacobi_update(ny, x, y, f1, g1);
+        ls ^= nega & (ny[0] >> 1);
+        for (int i = 0; i < 4; i++) {
+            x[i] = nx[i];
+            y[i] = ny[i];
+        }
+    }
 
-    // Print R2 in hex
-    printf("DEBUG - R2    : ");
-    for (int i = 0; i < NBLOCK; i++)
-        printf("%016llx ", _r2.bitsu64[i]);
-    printf("\n");
+    if ((y[0] ^ 1) | y[1] | y[2] | y[3])
+        return 0;
+    return (ls & 1) ? -1 : 1;
 }
 
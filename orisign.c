@@ -104,9 +104,6 @@ int main() {
     printf("  > System Throughput    : %.1f sig/sec\n", 1.0 / (t_sign + t_ver));
     printf("==============================================================\n");
 
-    oriint_setup_mm64_msize();
-    oriint_setup_r2();
-
     oriint_t a, b, res, check, one;
     int i;
 
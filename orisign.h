@@ -31,6 +31,9 @@ static inline ThetaNullPoint_Fp2 get_nist_baseline_theta(void)
 static inline void apply_isogeny_chain_challenge(ThetaNullPoint_Fp2 *T, const uint8_t chal[HASHES_BYTES])
 {
     _Static_assert(SQ_POWER_OLD <= (HASHES_BYTES * 8), "Error: SQ_POWER lebih besar dari jumlah bit yang tersedia di challenge hash!");
+    // Rantai proyektif: satu canonicalize_theta di akhir, hasil identik
+    // (lihat apply_quaternion_to_theta_chain di theta_old.h)
+    uint64_t zero = 0;
     for (int i = 0; i < SQ_POWER_OLD; i++) {
         uint8_t byte = chal[i >> 3];
         uint64_t bit = (uint64_t)((byte >> (i & 7)) & 1u);
@@ -39,15 +42,42 @@ static inline void apply_isogeny_chain_challenge(ThetaNullPoint_Fp2 *T, const ui
         xT.re = ct_select_u64(T->c.re, T->b.re, bit);
         xT.im = ct_select_u64(T->c.im, T->b.im, bit);
 
-        eval_sq_isogeny_velu_theta(T, xT);
-        canonicalize_theta(T);
+        if (i == 0)
+            eval_sq_isogeny_velu_theta(T, xT);
+        else
+            eval_sq_isogeny_velu_theta_proj(T, xT);
+        zero |= -(uint64_t)fp2_is_zero(T->a);
     }
+    canonicalize_theta(T);
+    T->a = fp2_cmov((fp2old_t){0, 0}, T->a, zero);
+    T->b = fp2_cmov((fp2old_t){0, 0}, T->b, zero);
+    T->c = fp2_cmov((fp2old_t){0, 0}, T->c, zero);
+    T->d = fp2_cmov((fp2old_t){0, 0}, T->d, zero);
+}
+
+/* Verification side: chal and T are public */
+static inline void apply_isogeny_chain_challenge_vartime(ThetaNullPoint_Fp2 *T, const uint8_t chal[HASHES_BYTES])
+{
+    for (int i = 0; i < SQ_POWER_OLD; i++) {
+        uint8_t byte = chal[i >> 3];
+        fp2old_t xT = ((byte >> (i & 7)) & 1u) ? T->b : T->c;
+
+        if (i == 0)
+            eval_sq_isogeny_velu_theta(T, xT);
+        else
+            eval_sq_isogeny_velu_theta_proj(T, xT);
+        if (fp2_is_zero(T->a)) {
+            *T = (ThetaNullPoint_Fp2){ { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 } };
+            return;
+        }
+    }
+    canonicalize_theta_vartime(T);
 }
 
 /* ============================================================
  * 2. CHALLENGE HASH (Hardened against Struct Padding)
  * ============================================================ */
-static inline void get_nist_challenge_v3(uint8_t *hash_out, const char* msg, ThetaNullPoint_Fp2 comm, ThetaNullPoint_Fp2 pk)
+static inline void get_nist_challenge_compressed(uint8_t *hash_out, const char* msg, ThetaCompressed_Fp2 cc, ThetaCompressed_Fp2 pkc)
 {
     shake256incctx ctx;
     shake256_inc_init(&ctx);
@@ -55,8 +85,6 @@ static inline void get_nist_challenge_v3(uint8_t *hash_out, const char* msg, The
     shake256_inc_absorb(&ctx, (const uint8_t*)msg, strlen(msg));
 
     uint8_t buf[FP2_BYTES_OLD];
-    ThetaCompressed_Fp2 cc = theta_compress(comm);
-    ThetaCompressed_Fp2 pkc = theta_compress(pk);
 
     fp2_pack(buf, cc.b); shake256_inc_absorb(&ctx, buf, FP2_BYTES_OLD);
     fp2_pack(buf, cc.c); shake256_inc_absorb(&ctx, buf, FP2_BYTES_OLD);
@@ -70,6 +98,17 @@ static inline void get_nist_challenge_v3(uint8_t *hash_out, const char* msg, The
     shake256_inc_squeeze(hash_out, HASHES_BYTES, &ctx);
 }
 
+static inline void get_nist_challenge_v3(uint8_t *hash_out, const char* msg, ThetaNullPoint_Fp2 comm, ThetaNullPoint_Fp2 pk)
+{
+    get_nist_challenge_compressed(hash_out, msg, theta_compress(comm), theta_compress(pk));
+}
+
+/* Verification side: comm and pk are public */
+static inline void get_nist_challenge_v3_vartime(uint8_t *hash_out, const char* msg, ThetaNullPoint_Fp2 comm, ThetaNullPoint_Fp2 pk)
+{
+    get_nist_challenge_compressed(hash_out, msg, theta_compress_vartime(comm), theta_compress_vartime(pk));
+}
+
 /* ============================================================
  * 3. KEY GENERATION & DERIVATION
  * ============================================================ */
@@ -79,29 +118,18 @@ static inline void get_nist_challenge_v3(uint8_t *hash_out, const char* msg, The
  * ============================================================ */
 static inline void apply_quaternion_action_to_theta(ThetaNullPoint_Fp2 *T, Quaternion q)
 {
-    // 1. Pra-komputasi (Hanya 4 kali encode, bukan 16)
-    uint64_t w = fp_encode_signed(q.w);
-    uint64_t x = fp_encode_signed(q.x);
-    uint64_t y = fp_encode_signed(q.y);
-    uint64_t z = fp_encode_signed(q.z);
+    // 1. Koefisien KLPT kecil (bertanda): langsung dipakai, tanpa fp_encode_signed
+    const int64_t s[4] = { (int64_t)q.w, (int64_t)q.x, (int64_t)q.y, (int64_t)q.z };
 
     // Simpan koordinat lama untuk menghindari aliasing
     fp2old_t a = T->a, b = T->b, c = T->c, d = T->d;
 
-    // 2. Linear Combination dengan register lokal
-    // Batch 1: a' dan b'
-    T->a = fp2_add(fp2_add(fp2_mul_scalar(a, w), fp2_mul_scalar(b, x)),
-                   fp2_add(fp2_mul_scalar(c, y), fp2_mul_scalar(d, z)));
-
-    T->b = fp2_add(fp2_sub(fp2_mul_scalar(b, w), fp2_mul_scalar(a, x)),
-                   fp2_sub(fp2_mul_scalar(d, y), fp2_mul_scalar(c, z)));
-
-    // Batch 2: c' dan d'
-    T->c = fp2_sub(fp2_sub(fp2_mul_scalar(c, w), fp2_mul_scalar(d, x)),
-                   fp2_sub(fp2_mul_scalar(a, y), fp2_mul_scalar(b, z)));
-
-    T->d = fp2_add(fp2_sub(fp2_mul_scalar(d, w), fp2_mul_scalar(c, x)),
-                   fp2_sub(fp2_mul_scalar(b, y), fp2_mul_scalar(a, z)));
+    // 2. Linear Combination: satu reduksi per koordinat (fp2_mul_sum_small)
+    // bit i dari mask = suku ke-i dikurangkan
+    T->a = fp2_mul_sum_small((const fp2old_t[4]){ a, b, c, d }, s, 4, 0x0);
+    T->b = fp2_mul_sum_small((const fp2old_t[4]){ b, a, d, c }, s, 4, 0xa);
+    T->c = fp2_mul_sum_small((const fp2old_t[4]){ c, d, a, b }, s, 4, 0x6);
+    T->d = fp2_mul_sum_small((const fp2old_t[4]){ d, c, b, a }, s, 4, 0xa);
 
     canonicalize_theta(T);
 }
@@ -263,29 +291,30 @@ static inline bool sign_v9(SQISignature_V9 *sig_out, const char* msg, Quaternion
 
 static inline bool verify_v9(const char* msg, SQISignature_V9 *sig, ThetaNullPoint_Fp2 pk_theta)
 {
+    // Semua input verifikasi publik: jalur _vartime aman dipakai di sini
     // 1. Derivasi Public Key dengan pengecekan titik tak hingga
     if (theta_is_infinity(pk_theta)) return false; 
 
     // 2. Dekompresi titik signature
-    ThetaNullPoint_Fp2 src = theta_decompress(sig->src);
+    ThetaNullPoint_Fp2 src = theta_decompress_vartime(sig->src);
     ThetaNullPoint_Fp2 tgt = src;
-    apply_isogeny_chain_challenge(&tgt, sig->challenge_val);
-    canonicalize_theta(&tgt);
+    apply_isogeny_chain_challenge_vartime(&tgt, sig->challenge_val);
+    canonicalize_theta_vartime(&tgt);
 
     // Pastikan titik yang didekompresi bukan sampah memori atau titik tak hingga
     if (theta_is_infinity(src) || theta_is_infinity(tgt)) return false;
 
     // 3. Verifikasi Challenge Hash (Cek integritas pesan & kunci)
     uint8_t check[HASHES_BYTES];
-    get_nist_challenge_v3(check, msg, src, pk_theta);
+    get_nist_challenge_v3_vartime(check, msg, src, pk_theta);
     if (memcmp(check, sig->challenge_val, HASHES_BYTES) != 0) return false;
 
     // 4. Rekonstruksi Jalur Isogeni (The "Climb")
     ThetaNullPoint_Fp2 W = src;
-    apply_isogeny_chain_challenge(&W, sig->challenge_val);
+    apply_isogeny_chain_challenge_vartime(&W, sig->challenge_val);
     
     // Gunakan canonicalize_theta yang sudah kita perbaiki tadi
-    canonicalize_theta(&W);
+    canonicalize_theta_vartime(&W);
 
     // 5. Constant-time Comparison
     // Membandingkan b, c, dan d (karena a sudah dipaksa jadi 1 oleh canonicalize)
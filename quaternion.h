@@ -2,11 +2,35 @@
 #include "fp.h"
 #include "types.h"
 
+/* Components are reduced F_p elements in Montgomery form, see fp.h. */
+
+static inline void quat_reduce(quaternion_t *RES) {
+    fp_reduce(&RES->w);
+    fp_reduce(&RES->x);
+    fp_reduce(&RES->y);
+    fp_reduce(&RES->z);
+}
+
+static inline void quat_store(quaternion_packed_t *RES, quaternion_t *a) {
+    fp_store(&RES->w, &a->w);
+    fp_store(&RES->x, &a->x);
+    fp_store(&RES->y, &a->y);
+    fp_store(&RES->z, &a->z);
+}
+
+static inline void quat_load(quaternion_t *RES, quaternion_packed_t *a) {
+    fp_load(&RES->w, &a->w);
+    fp_load(&RES->x, &a->x);
+    fp_load(&RES->y, &a->y);
+    fp_load(&RES->z, &a->z);
+}
+
 static inline void quat_add(quaternion_t *RES, quaternion_t *a, quaternion_t *b) {
     fp_add(&RES->w, &a->w, &b->w);
     fp_add(&RES->x, &a->x, &b->x);
     fp_add(&RES->y, &a->y, &b->y);
     fp_add(&RES->z, &a->z, &b->z);
+    quat_reduce(RES);
 }
 
 static inline void quat_mul(quaternion_t *RES, quaternion_t *a, quaternion_t *b) {
@@ -17,6 +41,10 @@ static inline void quat_mul(quaternion_t *RES, quaternion_t *a, quaternion_t *b)
     oriint_t v4;
     oriint_t v5;
 
+    // Each coordinate is a signed sum of four products (< P each) with at
+    // most three fp_sub, reduced once on store
+    _Static_assert(FP_BOUND_SUB(FP_BOUND_SUB(FP_BOUND_SUB(1))) <= FP_SUB_WIDE_PAD, "quat_mul bound");
+
     fp_mul(&v0, &a->w, &b->w);
     fp_mul(&v1, &a->x, &b->x);
     fp_sub(&v2, &v0, &v1);
@@ -68,7 +96,9 @@ static inline void quat_mul(quaternion_t *RES, quaternion_t *a, quaternion_t *b)
     fp_mul(&v3, &a->z, &b->w);
     fp_add(&v4, &v2, &v3);
     fp_mul(&v5, &a->x, &b->y);
-    fp_add(&RES->y, &v4, &v5);
+    fp_add(&RES->z, &v4, &v5);
+
+    quat_reduce(RES);
 }
 
 static inline void quat_norm(oriint_t *RES, quaternion_t *a) {
@@ -79,12 +109,13 @@ static inline void quat_norm(oriint_t *RES, quaternion_t *a) {
     oriint_t n4;
     oriint_t n5;
 
-    fp_mul(&n0, &a->w, &a->w);
-    fp_mul(&n1, &a->x, &a->x);
-    fp_mul(&n2, &a->y, &a->y);
-    fp_mul(&n3, &a->z, &a->z);
+    fp_sqr(&n0, &a->w);
+    fp_sqr(&n1, &a->x);
+    fp_sqr(&n2, &a->y);
+    fp_sqr(&n3, &a->z);
     fp_add(&n4, &n0, &n1);
     fp_add(&n5, &n4, &n2);
     fp_add(RES, &n5, &n3);
+    fp_reduce(RES);
 }
 
@@ -5,6 +5,7 @@
 
 #include "constants.h"
 #include "fp.h"
+#include "fp4.h"
 #include "types.h"
 
 static inline void canonicalize_theta(thetanullpoint_t *T) {
@@ -21,23 +22,113 @@ static inline void canonicalize_theta(thetanullpoint_t *T) {
     fp2_mul(&T->b, &T->b, &inva);
     fp2_mul(&T->c, &T->c, &inva);
     fp2_mul(&T->d, &T->d, &inva);
+    fp2_reduce(&T->b);
+    fp2_reduce(&T->c);
+    fp2_reduce(&T->d);
+}
+
+// canonicalize_theta for public points only
+static inline void canonicalize_theta_vartime(thetanullpoint_t *T) {
+    if (fp2_is_zero(&T->a)) {
+        fp2_clear(&T->a);
+        fp2_clear(&T->b);
+        fp2_clear(&T->c);
+        fp2_clear(&T->d);
+        return;
+    }
+    fp2_t inva;
+    fp2_inv_vartime(&inva, &T->a);
+    fp2_set_one(&T->a);
+    fp2_mul(&T->b, &T->b, &inva);
+    fp2_mul(&T->c, &T->c, &inva);
+    fp2_mul(&T->d, &T->d, &inva);
+    fp2_reduce(&T->b);
+    fp2_reduce(&T->c);
+    fp2_reduce(&T->d);
+}
+
+static inline void theta_store(thetapacked_t *RES, thetanullpoint_t *T) {
+    fp2_store(&RES->a, &T->a);
+    fp2_store(&RES->b, &T->b);
+    fp2_store(&RES->c, &T->c);
+    fp2_store(&RES->d, &T->d);
+}
+
+static inline void theta_load(thetanullpoint_t *RES, thetapacked_t *T) {
+    fp2_load(&RES->a, &T->a);
+    fp2_load(&RES->b, &T->b);
+    fp2_load(&RES->c, &T->c);
+    fp2_load(&RES->d, &T->d);
 }
 
 static inline void theta_compress(thetacompressed_t *RES, thetanullpoint_t *T) {
     canonicalize_theta(T);
-    fp2_set(&RES->b, &T->b);
-    fp2_set(&RES->c, &T->c);
-    fp2_set(&RES->d, &T->d);
+    fp2_store(&RES->b, &T->b);
+    fp2_store(&RES->c, &T->c);
+    fp2_store(&RES->d, &T->d);
 }
 
 static inline void theta_decompress(thetanullpoint_t *RES, thetacompressed_t *C) {
     fp2_set_one(&RES->a);
-    fp2_set(&RES->b, &C->b);
-    fp2_set(&RES->c, &C->c);
-    fp2_set(&RES->d, &C->d);
+    fp2_load(&RES->b, &C->b);
+    fp2_load(&RES->c, &C->c);
+    fp2_load(&RES->d, &C->d);
     canonicalize_theta(RES);
 }
 
+static inline void theta_decompress_vartime(thetanullpoint_t *RES, thetacompressed_t *C) {
+    fp2_set_one(&RES->a);
+    fp2_load(&RES->b, &C->b);
+    fp2_load(&RES->c, &C->c);
+    fp2_load(&RES->d, &C->d);
+    canonicalize_theta_vartime(RES);
+}
+
+#define THETA_BATCH_CHUNK 16
+
+// canonicalize_theta over n points with one field inversion per
+// THETA_BATCH_CHUNK points. A point with a == 0 becomes all zero, as in
+// canonicalize_theta, but without a branch.
+static inline void canonicalize_theta_batch(thetanullpoint_t *T, size_t n) {
+    fp2_t a[THETA_BATCH_CHUNK];
+    fp2_t inva[THETA_BATCH_CHUNK];
+    fp2_t one;
+    fp2_t zero;
+
+    fp2_set_one(&one);
+    fp2_clear(&zero);
+
+    for (size_t base = 0; base < n; base += THETA_BATCH_CHUNK) {
+        size_t m = (n - base < THETA_BATCH_CHUNK) ? n - base : THETA_BATCH_CHUNK;
+
+        for (size_t i = 0; i < m; i++)
+            fp2_set(&a[i], &T[base + i].a);
+        fp2_inv_batch(inva, a, m);
+
+        for (size_t i = 0; i < m; i++) {
+            thetanullpoint_t *t = &T[base + i];
+            uint64_t z = fp_zero_mask(&a[i].re) & fp_zero_mask(&a[i].im);
+            // inva is 0 when a is, which zeroes b, c and d as well
+            fp2_cmov(&t->a, &one, &zero, z);
+            fp2_mul(&t->b, &t->b, &inva[i]);
+            fp2_mul(&t->c, &t->c, &inva[i]);
+            fp2_mul(&t->d, &t->d, &inva[i]);
+            fp2_reduce(&t->b);
+            fp2_reduce(&t->c);
+            fp2_reduce(&t->d);
+        }
+    }
+}
+
+static inline void theta_compress_batch(thetacompressed_t *RES, thetanullpoint_t *T, size_t n) {
+    canonicalize_theta_batch(T, n);
+    for (size_t i = 0; i < n; i++) {
+        fp2_store(&RES[i].b, &T[i].b);
+        fp2_store(&RES[i].c, &T[i].c);
+        fp2_store(&RES[i].d, &T[i].d);
+    }
+}
+
 static inline bool theta_is_infinity(thetanullpoint_t *T) {
     return fp2_is_zero(&T->a) &
            fp2_is_zero(&T->b) &
@@ -45,7 +136,9 @@ static inline bool theta_is_infinity(thetanullpoint_t *T) {
            fp2_is_zero(&T->d);
 }
 
-static inline void eval_sq_isogeny_velu_theta(thetanullpoint_t *T, fp2_t *xT) {
+// T and xT reduced. The Hadamard sums stay unreduced into the squarings
+// and the four outputs are reduced once at the end.
+static inline void eval_sq_isogeny_velu_theta_scalar(thetanullpoint_t *T, fp2_t *xT) {
     fp2_t a;
     fp2_t b;
     fp2_t c;
@@ -61,6 +154,12 @@ static inline void eval_sq_isogeny_velu_theta(thetanullpoint_t *T, fp2_t *xT) {
     fp2_t xcpd2;
     fp2_t xcmd2;
 
+    // apb < 2P, amb < 5P into fp2_sqr; apb2 < P out of it and xcpd2 < P
+    // out of fp2_mul
+    _Static_assert(FP_BOUND_SUB(1) <= 16, "theta step: fp2_sqr input bound");
+    _Static_assert(1 <= FP_SUB_PAD, "theta step: subtrahend bound");
+    _Static_assert(FP_BOUND_SUB(1) <= FP_BOUND_MUL, "theta step: output bound");
+
     fp2_set(&a, &T->a);
     fp2_set(&b, &T->b);
     fp2_set(&c, &T->c);
@@ -71,10 +170,10 @@ static inline void eval_sq_isogeny_velu_theta(thetanullpoint_t *T, fp2_t *xT) {
     fp2_add(&cpd, &c, &d);
     fp2_sub(&cmd, &c, &d);
 
-    fp2_mul(&apb2, &apb, &apb);
-    fp2_mul(&amb2, &amb, &amb);
-    fp2_mul(&cpd2, &cpd, &cpd);
-    fp2_mul(&cmd2, &cmd, &cmd);
+    fp2_sqr(&apb2, &apb);
+    fp2_sqr(&amb2, &amb);
+    fp2_sqr(&cpd2, &cpd);
+    fp2_sqr(&cmd2, &cmd);
 
     fp2_mul(&xcpd2, xT, &cpd2);
     fp2_mul(&xcmd2, xT, &cmd2);
@@ -83,9 +182,209 @@ static inline void eval_sq_isogeny_velu_theta(thetanullpoint_t *T, fp2_t *xT) {
     fp2_sub(&T->b, &apb2, &xcpd2);
     fp2_add(&T->c, &amb2, &xcmd2);
     fp2_sub(&T->d, &amb2, &xcmd2);
+
+    fp2_reduce(&T->a);
+    fp2_reduce(&T->b);
+    fp2_reduce(&T->c);
+    fp2_reduce(&T->d);
 }
 
-static inline void apply_quaternion_to_theta_chain(thetanullpoint_t *T, oriint_t *challenge) {
+#ifndef ORIINT_PORTABLE
+// The same step on fp4.h with lanes (a, b, c, d). Formulas follow the
+// scalar path (fp2_sqr, then fp2_mul by xT), so the reduced outputs are
+// bit-identical. Bounds in multiples of P noted at each stage.
+FP4_TARGET static inline void eval_sq_isogeny_velu_theta_x4(thetanullpoint_t *T, fp2_t *xT) {
+    fp4_t re, im, xre, xim;
+    fp4_t u, v, s, d;
+    fp4_t hre, him, qre, qim, ab;
+    fp4_t vre, vim, ac, bd, t1, t2, p, wre, wim;
+
+    // < 16P
+    fp4_load(&re, &T->a.re, &T->b.re, &T->c.re, &T->d.re);
+    fp4_load(&im, &T->a.im, &T->b.im, &T->c.im, &T->d.im);
+    fp4_load(&xre, &xT->re, &xT->re, &xT->re, &xT->re);
+    fp4_load(&xim, &xT->im, &xT->im, &xT->im, &xT->im);
+
+    // (a + b, a - b, c + d, c - d) < 32P
+    FP4_PERMUTE(&u, &re, 0xa0);
+    FP4_PERMUTE(&v, &re, 0xf5);
+    fp4_add(&s, &u, &v);
+    fp4_sub(&d, &u, &v);
+    fp4_blend_odd(&hre, &s, &d);
+    FP4_PERMUTE(&u, &im, 0xa0);
+    FP4_PERMUTE(&v, &im, 0xf5);
+    fp4_add(&s, &u, &v);
+    fp4_sub(&d, &u, &v);
+    fp4_blend_odd(&him, &s, &d);
+
+    // Squares: re = (re + im)(re - im) < 6P, im = 2 re im < 5P
+    fp4_add(&s, &hre, &him);
+    fp4_sub(&d, &hre, &him);
+    fp4_mul(&qre, &s, &d);
+    fp4_mul(&ab, &hre, &him);
+    fp4_add(&qim, &ab, &ab);
+
+    // x * (cpd2, cpd2, cmd2, cmd2) as fp2_mul (Karatsuba); sums < 32P and
+    // < 11P, products < 2P, w < 66P
+    FP4_PERMUTE(&vre, &qre, 0xfa);
+    FP4_PERMUTE(&vim, &qim, 0xfa);
+    fp4_mul(&ac, &xre, &vre);
+    fp4_mul(&bd, &xim, &vim);
+    fp4_add(&t1, &xre, &xim);
+    fp4_add(&t2, &vre, &vim);
+    fp4_sub(&wre, &ac, &bd);
+    fp4_mul(&p, &t1, &t2);
+    fp4_sub(&wim, &p, &ac);
+    fp4_sub(&wim, &wim, &bd);
+
+    // (apb2 + xcpd2, apb2 - xcpd2, amb2 + xcmd2, amb2 - xcmd2) < 134P
+    FP4_PERMUTE(&u, &qre, 0x50);
+    fp4_add(&s, &u, &wre);
+    fp4_sub_wide(&d, &u, &wre);
+    fp4_blend_odd(&re, &s, &d);
+    FP4_PERMUTE(&u, &qim, 0x50);
+    fp4_add(&s, &u, &wim);
+    fp4_sub_wide(&d, &u, &wim);
+    fp4_blend_odd(&im, &s, &d);
+
+    fp4_store(&T->a.re, &T->b.re, &T->c.re, &T->d.re, &re);
+    fp4_store(&T->a.im, &T->b.im, &T->c.im, &T->d.im, &im);
+}
+#endif
+
+static inline void eval_sq_isogeny_velu_theta(thetanullpoint_t *T, fp2_t *xT) {
+#ifndef ORIINT_PORTABLE
+    if (oriint_cpu_ifma) {
+        eval_sq_isogeny_velu_theta_x4(T, xT);
+        return;
+    }
+#endif
+    eval_sq_isogeny_velu_theta_scalar(T, xT);
+}
+
+// The step on a projective T = l * (1, b, c, d). apb2 and amb2 are scaled
+// by a = l so that they match xT * cpd2 with xT = b or c taken from T
+// (scaled by l as well): the result is l^3 times the step on (1, b, c, d).
+// Bounds as in the scalar step; a * apb2 < P.
+static inline void eval_sq_isogeny_velu_theta_proj(thetanullpoint_t *T, fp2_t *xT) {
+    fp2_t a;
+    fp2_t apb;
+    fp2_t amb;
+    fp2_t cpd;
+    fp2_t cmd;
+    fp2_t apb2;
+    fp2_t amb2;
+    fp2_t cpd2;
+    fp2_t cmd2;
+    fp2_t xcpd2;
+    fp2_t xcmd2;
+
+    fp2_set(&a, &T->a);
+    fp2_add(&apb, &a, &T->b);
+    fp2_sub(&amb, &a, &T->b);
+    fp2_add(&cpd, &T->c, &T->d);
+    fp2_sub(&cmd, &T->c, &T->d);
+
+    fp2_sqr(&apb2, &apb);
+    fp2_sqr(&amb2, &amb);
+    fp2_sqr(&cpd2, &cpd);
+    fp2_sqr(&cmd2, &cmd);
+
+    fp2_mul(&apb2, &apb2, &a);
+    fp2_mul(&amb2, &amb2, &a);
+    fp2_mul(&xcpd2, xT, &cpd2);
+    fp2_mul(&xcmd2, xT, &cmd2);
+
+    fp2_add(&T->a, &apb2, &xcpd2);
+    fp2_sub(&T->b, &apb2, &xcpd2);
+    fp2_add(&T->c, &amb2, &xcmd2);
+    fp2_sub(&T->d, &amb2, &xcmd2);
+
+    fp2_reduce(&T->a);
+    fp2_reduce(&T->b);
+    fp2_reduce(&T->c);
+    fp2_reduce(&T->d);
+}
+
+// Dual coordinates. A step ends in the butterfly (A + X, A - X, B + Y,
+// B - Y) with A = a * apb2, X = xT * cpd2, B = a * amb2, Y = xT * cmd2, and
+// the next step opens with the same butterfly, which gives back
+// 2 * (A, X, B, Y). The chain keeps (A, X, B, Y) in the fields (a, b, c, d)
+// instead: up to the factor 4 a step is then four squarings and four
+// products, and only a = A + X and xK = A - X or B + Y are formed. The
+// products are those of the projective step, so only the add/subs and
+// reductions go: a < 2P takes the zero test without a reduction
+// (fp2_is_zero_2p), and the chain comes out about 10% faster.
+
+// The step on T, left in dual coordinates. T and xT reduced; A, X, B,
+// Y < P.
+static inline void eval_sq_isogeny_velu_theta_to_dual(thetanullpoint_t *D, thetanullpoint_t *T, fp2_t *xT) {
+    fp2_t apb;
+    fp2_t amb;
+    fp2_t cpd;
+    fp2_t cmd;
+    fp2_t cpd2;
+    fp2_t cmd2;
+    fp2_t x;
+
+    fp2_set(&x, xT);
+    fp2_add(&apb, &T->a, &T->b);
+    fp2_sub(&amb, &T->a, &T->b);
+    fp2_add(&cpd, &T->c, &T->d);
+    fp2_sub(&cmd, &T->c, &T->d);
+
+    fp2_sqr(&cpd2, &cpd);
+    fp2_sqr(&cmd2, &cmd);
+    fp2_mul(&D->b, &x, &cpd2);
+    fp2_mul(&D->d, &x, &cmd2);
+    fp2_sqr(&D->a, &apb);
+    fp2_sqr(&D->c, &amb);
+}
+
+// The step on a point in dual coordinates; a = A + X and xT = A - X or
+// B + Y come from the caller. Inputs < 16P, outputs < P.
+static inline void eval_sq_isogeny_velu_theta_dual(thetanullpoint_t *D, fp2_t *a, fp2_t *xT) {
+    fp2_t a2;
+    fp2_t x2;
+    fp2_t b2;
+    fp2_t y2;
+
+    fp2_sqr(&a2, &D->a);
+    fp2_sqr(&x2, &D->b);
+    fp2_sqr(&b2, &D->c);
+    fp2_sqr(&y2, &D->d);
+
+    fp2_mul(&D->a, &a2, a);
+    fp2_mul(&D->b, &b2, xT);
+    fp2_mul(&D->c, &x2, a);
+    fp2_mul(&D->d, &y2, xT);
+}
+
+// (A + X, A - X, B + Y, B - Y), reduced
+static inline void theta_from_dual(thetanullpoint_t *RES, thetanullpoint_t *D) {
+    fp2_t a;
+    fp2_t b;
+    fp2_t c;
+    fp2_t d;
+
+    fp2_add(&a, &D->a, &D->b);
+    fp2_sub(&b, &D->a, &D->b);
+    fp2_add(&c, &D->c, &D->d);
+    fp2_sub(&d, &D->c, &D->d);
+
+    fp2_reduce(&a);
+    fp2_reduce(&b);
+    fp2_reduce(&c);
+    fp2_reduce(&d);
+    fp2_set(&RES->a, &a);
+    fp2_set(&RES->b, &b);
+    fp2_set(&RES->c, &c);
+    fp2_set(&RES->d, &d);
+}
+
+// The chain with canonicalize_theta after every step, kept as the reference
+// for apply_quaternion_to_theta_chain
+static inline void apply_quaternion_to_theta_chain_canonical(thetanullpoint_t *T, oriint_t *challenge) {
     for (int i = 0; i < SQ_POWER; i++) {
         uint64_t word  = (uint64_t)i >> 6;
         uint64_t shift = (uint64_t)i & 63;
@@ -98,6 +397,434 @@ static inline void apply_quaternion_to_theta_chain(thetanullpoint_t *T, oriint_t
     }
 }
 
+// Projective chain: the first step runs on T as given, like the canonical
+// chain, and the point is then carried unnormalized with one
+// canonicalize_theta at the end instead of SQ_POWER. Once a step yields
+// a == 0 the canonical chain stays at the zero point; that is tracked in
+// a mask, so the result is bit-identical.
+static inline void apply_quaternion_to_theta_chain_proj(thetanullpoint_t *T, oriint_t *challenge) {
+    uint64_t zero = 0;
+    thetanullpoint_t Z;
+
+    for (int i = 0; i < SQ_POWER; i++) {
+        uint64_t word  = (uint64_t)i >> 6;
+        uint64_t shift = (uint64_t)i & 63;
+        uint64_t bit = (challenge->bitsu64[word] >> shift) & 1ULL;
+        uint64_t mask = (uint64_t)-(int64_t)bit;
+        fp2_t xK;
+        fp2_cmov(&xK, &T->b, &T->c, mask);
+        if (i == 0)
+            eval_sq_isogeny_velu_theta(T, &xK);
+        else
+            eval_sq_isogeny_velu_theta_proj(T, &xK);
+        zero |= 0 - (uint64_t)fp2_is_zero(&T->a);
+    }
+
+    canonicalize_theta(T);
+    memset(&Z, 0, sizeof(Z));
+    fp2_cmov(&T->a, &T->a, &Z.a, zero);
+    fp2_cmov(&T->b, &T->b, &Z.b, zero);
+    fp2_cmov(&T->c, &T->c, &Z.c, zero);
+    fp2_cmov(&T->d, &T->d, &Z.d, zero);
+}
+
+// The projective chain in dual coordinates: T is converted after the
+// first step and back before the final canonicalize_theta. Same result
+// as the canonical chain, zero mask as in the projective one.
+static inline void apply_quaternion_to_theta_chain(thetanullpoint_t *T, oriint_t *challenge) {
+    uint64_t zero = 0;
+    uint64_t mask = (uint64_t)0 - (challenge->bitsu64[0] & 1ULL);
+    thetanullpoint_t Z;
+    fp2_t a;
+    fp2_t b;
+    fp2_t c;
+    fp2_t xK;
+
+    _Static_assert(FP_BOUND_SUB(1) <= 16, "dual chain: fp2_mul input bound");
+
+    fp2_cmov(&xK, &T->b, &T->c, mask);
+    eval_sq_isogeny_velu_theta_to_dual(T, T, &xK);
+
+    for (int i = 1; i < SQ_POWER; i++) {
+        uint64_t word  = (uint64_t)i >> 6;
+        uint64_t shift = (uint64_t)i & 63;
+        uint64_t bit = (challenge->bitsu64[word] >> shift) & 1ULL;
+        mask = (uint64_t)-(int64_t)bit;
+
+        fp2_add(&a, &T->a, &T->b);
+        fp2_sub(&b, &T->a, &T->b);
+        fp2_add(&c, &T->c, &T->d);
+        zero |= 0 - (uint64_t)fp2_is_zero_2p(&a);
+        fp2_cmov(&xK, &b, &c, mask);
+        eval_sq_isogeny_velu_theta_dual(T, &a, &xK);
+    }
+
+    theta_from_dual(T, T);
+    canonicalize_theta(T);
+    memset(&Z, 0, sizeof(Z));
+    fp2_cmov(&T->a, &T->a, &Z.a, zero);
+    fp2_cmov(&T->b, &T->b, &Z.b, zero);
+    fp2_cmov(&T->c, &T->c, &Z.c, zero);
+    fp2_cmov(&T->d, &T->d, &Z.d, zero);
+}
+
+// Two dual steps for the challenge bits w & 1 and (w >> 1) & 1. The four
+// kernel choices differ only in xK for each half, so both are picked by
+// fp2_cmov and the point between the halves stays in locals. Returns the
+// zero mask of the two a's, as tracked by the chain.
+static inline uint64_t eval_4_isogeny_theta_dual(thetanullpoint_t *D, uint64_t w) {
+    uint64_t m0 = (uint64_t)0 - (w & 1);
+    uint64_t m1 = (uint64_t)0 - ((w >> 1) & 1);
+    uint64_t zero;
+    fp2_t a;
+    fp2_t b;
+    fp2_t c;
+    fp2_t xK;
+    fp2_t a2;
+    fp2_t x2;
+    fp2_t b2;
+    fp2_t y2;
+    thetanullpoint_t E;
+
+    fp2_add(&a, &D->a, &D->b);
+    fp2_sub(&b, &D->a, &D->b);
+    fp2_add(&c, &D->c, &D->d);
+    zero = 0 - (uint64_t)fp2_is_zero_2p(&a);
+    fp2_cmov(&xK, &b, &c, m0);
+    fp2_sqr(&a2, &D->a);
+    fp2_sqr(&x2, &D->b);
+    fp2_sqr(&b2, &D->c);
+    fp2_sqr(&y2, &D->d);
+    fp2_mul(&E.a, &a2, &a);
+    fp2_mul(&E.b, &b2, &xK);
+    fp2_mul(&E.c, &x2, &a);
+    fp2_mul(&E.d, &y2, &xK);
+
+    fp2_add(&a, &E.a, &E.b);
+    fp2_sub(&b, &E.a, &E.b);
+    fp2_add(&c, &E.c, &E.d);
+    zero |= 0 - (uint64_t)fp2_is_zero_2p(&a);
+    fp2_cmov(&xK, &b, &c, m1);
+    fp2_sqr(&a2, &E.a);
+    fp2_sqr(&x2, &E.b);
+    fp2_sqr(&b2, &E.c);
+    fp2_sqr(&y2, &E.d);
+    fp2_mul(&D->a, &a2, &a);
+    fp2_mul(&D->b, &b2, &xK);
+    fp2_mul(&D->c, &x2, &a);
+    fp2_mul(&D->d, &y2, &xK);
+
+    return zero;
+}
+
+// Radix-4 form of apply_quaternion_to_theta_chain with the same output:
+// bits 0 and 1 as in the bit-serial chain, then one eval_4_isogeny_theta_dual
+// per aligned pair of challenge bits.
+static inline void apply_quaternion_to_theta_chain_radix4(thetanullpoint_t *T, oriint_t *challenge) {
+    uint64_t zero = 0;
+    uint64_t mask = (uint64_t)0 - (challenge->bitsu64[0] & 1ULL);
+    thetanullpoint_t Z;
+    fp2_t a;
+    fp2_t b;
+    fp2_t c;
+    fp2_t xK;
+
+    _Static_assert(SQ_POWER % 2 == 0, "radix-4 chain: bit pairs");
+
+    fp2_cmov(&xK, &T->b, &T->c, mask);
+    eval_sq_isogeny_velu_theta_to_dual(T, T, &xK);
+
+    mask = (uint64_t)0 - ((challenge->bitsu64[0] >> 1) & 1ULL);
+    fp2_add(&a, &T->a, &T->b);
+    fp2_sub(&b, &T->a, &T->b);
+    fp2_add(&c, &T->c, &T->d);
+    zero |= 0 - (uint64_t)fp2_is_zero_2p(&a);
+    fp2_cmov(&xK, &b, &c, mask);
+    eval_sq_isogeny_velu_theta_dual(T, &a, &xK);
+
+    for (int i = 2; i < SQ_POWER; i += 2) {
+        uint64_t w = (challenge->bitsu64[i >> 6] >> (i & 63)) & 3ULL;
+        zero |= eval_4_isogeny_theta_dual(T, w);
+    }
+
+    theta_from_dual(T, T);
+    canonicalize_theta(T);
+    memset(&Z, 0, sizeof(Z));
+    fp2_cmov(&T->a, &T->a, &Z.a, zero);
+    fp2_cmov(&T->b, &T->b, &Z.b, zero);
+    fp2_cmov(&T->c, &T->c, &Z.c, zero);
+    fp2_cmov(&T->d, &T->d, &Z.d, zero);
+}
+
+// Verification side: challenge and T are public
+static inline void apply_quaternion_to_theta_chain_vartime(thetanullpoint_t *T, oriint_t *challenge) {
+    fp2_t a;
+    fp2_t xK;
+
+    eval_sq_isogeny_velu_theta_to_dual(T, T, (challenge->bitsu64[0] & 1) ? &T->c : &T->b);
+    for (int i = 1; i < SQ_POWER; i++) {
+        uint64_t bit = (challenge->bitsu64[i >> 6] >> (i & 63)) & 1ULL;
+        fp2_add(&a, &T->a, &T->b);
+        if (fp2_is_zero_2p(&a)) {
+            memset(T, 0, sizeof(*T));
+            return;
+        }
+        if (bit)
+            fp2_add(&xK, &T->c, &T->d);
+        else
+            fp2_sub(&xK, &T->a, &T->b);
+        eval_sq_isogeny_velu_theta_dual(T, &a, &xK);
+    }
+    theta_from_dual(T, T);
+    canonicalize_theta_vartime(T);
+}
+
+// Lanes of a theta_batch_t; unused lanes hold the zero point
+static inline void theta_batch_load(theta_batch_t *B, thetanullpoint_t *T, size_t n) {
+    memset(B, 0, sizeof(*B));
+    for (size_t i = 0; i < n; i++) {
+        fp2_set(&B->a[i], &T[i].a);
+        fp2_set(&B->b[i], &T[i].b);
+        fp2_set(&B->c[i], &T[i].c);
+        fp2_set(&B->d[i], &T[i].d);
+    }
+}
+
+static inline void theta_batch_store(thetanullpoint_t *T, theta_batch_t *B, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        fp2_set(&T[i].a, &B->a[i]);
+        fp2_set(&T[i].b, &B->b[i]);
+        fp2_set(&T[i].c, &B->c[i]);
+        fp2_set(&T[i].d, &B->d[i]);
+    }
+}
+
+#ifndef ORIINT_PORTABLE
+// Lanes g .. g + 3 of the batch chain on fp2x4_t, lane k of each vector
+// holding point g + k, so the four chains share every IFMA instruction.
+// The first step runs per lane as in the single chain. Bounds (fp4.h): the
+// dual point stays below 5P, a below 10P and xK below 37P. The zero test is
+// the product of the a's, zero exactly when one of them is.
+FP4_TARGET static inline void apply_quaternion_to_theta_chain_batch_x4(theta_batch_t *B, oriint_t *challenge, int g) {
+    fp2x4_t A, X, Bv, Y, a, b, c, xK, a2, x2, b2, y2, acc;
+    thetanullpoint_t T[4];
+    thetanullpoint_t Z;
+    fp2_t prod[4];
+    fp2_t one;
+
+    for (int k = 0; k < 4; k++) {
+        uint64_t mask = (uint64_t)0 - (challenge[g + k].bitsu64[0] & 1ULL);
+        fp2_t x;
+        fp2_set(&T[k].a, &B->a[g + k]);
+        fp2_set(&T[k].b, &B->b[g + k]);
+        fp2_set(&T[k].c, &B->c[g + k]);
+        fp2_set(&T[k].d, &B->d[g + k]);
+        fp2_cmov(&x, &T[k].b, &T[k].c, mask);
+        eval_sq_isogeny_velu_theta_to_dual(&T[k], &T[k], &x);
+    }
+    fp2x4_load(&A, &T[0].a, &T[1].a, &T[2].a, &T[3].a);
+    fp2x4_load(&X, &T[0].b, &T[1].b, &T[2].b, &T[3].b);
+    fp2x4_load(&Bv, &T[0].c, &T[1].c, &T[2].c, &T[3].c);
+    fp2x4_load(&Y, &T[0].d, &T[1].d, &T[2].d, &T[3].d);
+    fp2_set_one(&one);
+    fp2x4_load(&acc, &one, &one, &one, &one);
+
+    for (int i = 1; i < SQ_POWER; i++) {
+        int word  = i >> 6;
+        int shift = i & 63;
+        __m256i m = _mm256_set_epi64x(-(int64_t)((challenge[g + 3].bitsu64[word] >> shift) & 1ULL),
+                                      -(int64_t)((challenge[g + 2].bitsu64[word] >> shift) & 1ULL),
+                                      -(int64_t)((challenge[g + 1].bitsu64[word] >> shift) & 1ULL),
+                                      -(int64_t)((challenge[g].bitsu64[word] >> shift) & 1ULL));
+
+        fp2x4_add(&a, &A, &X);
+        fp2x4_sub(&b, &A, &X);
+        fp2x4_add(&c, &Bv, &Y);
+        fp2x4_select(&xK, &b, &c, m);
+        fp2x4_mul(&acc, &a, &acc);
+
+        fp2x4_sqr(&a2, &A);
+        fp2x4_sqr(&x2, &X);
+        fp2x4_sqr(&b2, &Bv);
+        fp2x4_sqr(&y2, &Y);
+        fp2x4_mul(&A, &a, &a2);
+        fp2x4_mul(&X, &xK, &b2);
+        fp2x4_mul(&Bv, &a, &x2);
+        fp2x4_mul(&Y, &xK, &y2);
+    }
+
+    fp2x4_store(&T[0].a, &T[1].a, &T[2].a, &T[3].a, &A);
+    fp2x4_store(&T[0].b, &T[1].b, &T[2].b, &T[3].b, &X);
+    fp2x4_store(&T[0].c, &T[1].c, &T[2].c, &T[3].c, &Bv);
+    fp2x4_store(&T[0].d, &T[1].d, &T[2].d, &T[3].d, &Y);
+    fp2x4_store(&prod[0], &prod[1], &prod[2], &prod[3], &acc);
+    for (int k = 0; k < 4; k++)
+        theta_from_dual(&T[k], &T[k]);
+    canonicalize_theta_batch(T, 4);
+    memset(&Z, 0, sizeof(Z));
+    for (int k = 0; k < 4; k++) {
+        uint64_t zero = 0 - (uint64_t)fp2_is_zero(&prod[k]);
+        fp2_cmov(&B->a[g + k], &T[k].a, &Z.a, zero);
+        fp2_cmov(&B->b[g + k], &T[k].b, &Z.b, zero);
+        fp2_cmov(&B->c[g + k], &T[k].c, &Z.c, zero);
+        fp2_cmov(&B->d[g + k], &T[k].d, &Z.d, zero);
+    }
+}
+#endif
+
+// apply_quaternion_to_theta_chain on every lane, lane i with challenge[i],
+// with the same result per lane. With IFMA the lanes go four to a vector
+// (apply_quaternion_to_theta_chain_batch_x4). The scalar path runs each
+// stage of the dual step across all lanes; a single chain already has four
+// independent products per stage, so there the gain is the final
+// normalization sharing one inversion (canonicalize_theta_batch).
+static inline void apply_quaternion_to_theta_chain_batch(theta_batch_t *B, oriint_t *challenge) {
+    uint64_t zero[THETA_BATCH_LANES] = { 0 };
+    uint64_t mask[THETA_BATCH_LANES];
+    fp2_t a[THETA_BATCH_LANES];
+    fp2_t xK[THETA_BATCH_LANES];
+    fp2_t a2[THETA_BATCH_LANES];
+    fp2_t x2[THETA_BATCH_LANES];
+    fp2_t b2[THETA_BATCH_LANES];
+    fp2_t y2[THETA_BATCH_LANES];
+    thetanullpoint_t T[THETA_BATCH_LANES];
+    thetanullpoint_t Z;
+
+    _Static_assert(THETA_BATCH_LANES % 4 == 0, "batch chain: lanes in groups of four");
+
+#ifndef ORIINT_PORTABLE
+    if (oriint_cpu_ifma) {
+        for (int g = 0; g < THETA_BATCH_LANES; g += 4)
+            apply_quaternion_to_theta_chain_batch_x4(B, challenge, g);
+        return;
+    }
+#endif
+
+    theta_batch_store(T, B, THETA_BATCH_LANES);
+    for (int j = 0; j < THETA_BATCH_LANES; j++) {
+        mask[j] = (uint64_t)0 - (challenge[j].bitsu64[0] & 1ULL);
+        fp2_cmov(&xK[j], &T[j].b, &T[j].c, mask[j]);
+        eval_sq_isogeny_velu_theta_to_dual(&T[j], &T[j], &xK[j]);
+    }
+    theta_batch_load(B, T, THETA_BATCH_LANES);
+
+    for (int i = 1; i < SQ_POWER; i++) {
+        uint64_t word  = (uint64_t)i >> 6;
+        uint64_t shift = (uint64_t)i & 63;
+
+        for (int j = 0; j < THETA_BATCH_LANES; j++) {
+            fp2_t b;
+            fp2_t c;
+            mask[j] = (uint64_t)0 - ((challenge[j].bitsu64[word] >> shift) & 1ULL);
+            fp2_add(&a[j], &B->a[j], &B->b[j]);
+            fp2_sub(&b, &B->a[j], &B->b[j]);
+            fp2_add(&c, &B->c[j], &B->d[j]);
+            zero[j] |= 0 - (uint64_t)fp2_is_zero_2p(&a[j]);
+            fp2_cmov(&xK[j], &b, &c, mask[j]);
+        }
+        for (int j = 0; j < THETA_BATCH_LANES; j++) {
+            fp2_sqr(&a2[j], &B->a[j]);
+            fp2_sqr(&x2[j], &B->b[j]);
+            fp2_sqr(&b2[j], &B->c[j]);
+            fp2_sqr(&y2[j], &B->d[j]);
+        }
+        for (int j = 0; j < THETA_BATCH_LANES; j++) {
+            fp2_mul(&B->a[j], &a2[j], &a[j]);
+            fp2_mul(&B->b[j], &b2[j], &xK[j]);
+            fp2_mul(&B->c[j], &x2[j], &a[j]);
+            fp2_mul(&B->d[j], &y2[j], &xK[j]);
+        }
+    }
+
+    theta_batch_store(T, B, THETA_BATCH_LANES);
+    for (int j = 0; j < THETA_BATCH_LANES; j++)
+        theta_from_dual(&T[j], &T[j]);
+    canonicalize_theta_batch(T, THETA_BATCH_LANES);
+    memset(&Z, 0, sizeof(Z));
+    for (int j = 0; j < THETA_BATCH_LANES; j++) {
+        fp2_cmov(&T[j].a, &T[j].a, &Z.a, zero[j]);
+        fp2_cmov(&T[j].b, &T[j].b, &Z.b, zero[j]);
+        fp2_cmov(&T[j].c, &T[j].c, &Z.c, zero[j]);
+        fp2_cmov(&T[j].d, &T[j].d, &Z.d, zero[j]);
+    }
+    theta_batch_load(B, T, THETA_BATCH_LANES);
+}
+
+// Batch entry for keygen and verification: n points, each with its own
+// challenge, THETA_BATCH_LANES at a time
+static inline void apply_quaternion_to_theta_chain_many(thetanullpoint_t *T, oriint_t *challenge, size_t n) {
+    theta_batch_t B;
+    oriint_t ch[THETA_BATCH_LANES];
+
+    for (size_t base = 0; base < n; base += THETA_BATCH_LANES) {
+        size_t m = (n - base < THETA_BATCH_LANES) ? n - base : THETA_BATCH_LANES;
+
+        memset(ch, 0, sizeof(ch));
+        memcpy(ch, &challenge[base], m * sizeof(oriint_t));
+        theta_batch_load(&B, &T[base], m);
+        apply_quaternion_to_theta_chain_batch(&B, ch);
+        theta_batch_store(&T[base], &B, m);
+    }
+}
+
+// T <- q . T as in orisign.h: each coordinate is a signed sum of four
+// products, one fp2_mul_sum each. q reduced (quat_reduce).
+static inline void apply_quaternion_action_to_theta(thetanullpoint_t *T, quaternion_t *q) {
+    thetanullpoint_t t = *T;
+    oriint_t *s[4] = { &q->w, &q->x, &q->y, &q->z };
+
+    fp2_mul_sum(&T->a, (fp2_t *[4]){ &t.a, &t.b, &t.c, &t.d }, s, 4, 0x0);
+    fp2_mul_sum(&T->b, (fp2_t *[4]){ &t.b, &t.a, &t.d, &t.c }, s, 4, 0xa);
+    fp2_mul_sum(&T->c, (fp2_t *[4]){ &t.c, &t.d, &t.a, &t.b }, s, 4, 0x6);
+    fp2_mul_sum(&T->d, (fp2_t *[4]){ &t.d, &t.c, &t.b, &t.a }, s, 4, 0xa);
+
+    canonicalize_theta(T);
+}
+
+// The same action for a quaternion with small signed integer coefficients
+// q = (w, x, y, z) (KLPT output, |q[i]| < 2^55), through fp2_mul_small.
+// Each coordinate is (sum of two products) - (sum of two), < 6P before the
+// final reduction. The result is projective: unlike the action above it
+// does not canonicalize, so a run of actions pays for one inversion when
+// the caller canonicalizes at the end.
+static inline void apply_small_quaternion_action_to_theta(thetanullpoint_t *T, const int64_t q[4]) {
+    fp2_t aw, ax, ay, az, bw, bx, by, bz, cw, cx, cy, cz, dw, dx, dy, dz;
+    fp2_t u, v;
+
+    _Static_assert(FP_BOUND_SUB(FP_BOUND_ADD(1, 1)) <= FP_BOUND_MUL, "small quaternion action bound");
+
+    fp2_mul_small(&aw, &T->a, q[0]); fp2_mul_small(&ax, &T->a, q[1]);
+    fp2_mul_small(&ay, &T->a, q[2]); fp2_mul_small(&az, &T->a, q[3]);
+    fp2_mul_small(&bw, &T->b, q[0]); fp2_mul_small(&bx, &T->b, q[1]);
+    fp2_mul_small(&by, &T->b, q[2]); fp2_mul_small(&bz, &T->b, q[3]);
+    fp2_mul_small(&cw, &T->c, q[0]); fp2_mul_small(&cx, &T->c, q[1]);
+    fp2_mul_small(&cy, &T->c, q[2]); fp2_mul_small(&cz, &T->c, q[3]);
+    fp2_mul_small(&dw, &T->d, q[0]); fp2_mul_small(&dx, &T->d, q[1]);
+    fp2_mul_small(&dy, &T->d, q[2]); fp2_mul_small(&dz, &T->d, q[3]);
+
+    // a' = aw + bx + cy + dz
+    fp2_add(&u, &aw, &bx);
+    fp2_add(&v, &cy, &dz);
+    fp2_add(&T->a, &u, &v);
+    // b' = (bw + dy) - (ax + cz)
+    fp2_add(&u, &bw, &dy);
+    fp2_add(&v, &ax, &cz);
+    fp2_sub(&T->b, &u, &v);
+    // c' = (cw + bz) - (dx + ay)
+    fp2_add(&u, &cw, &bz);
+    fp2_add(&v, &dx, &ay);
+    fp2_sub(&T->c, &u, &v);
+    // d' = (dw + by) - (cx + az)
+    fp2_add(&u, &dw, &by);
+    fp2_add(&v, &cx, &az);
+    fp2_sub(&T->d, &u, &v);
+
+    fp2_reduce(&T->a);
+    fp2_reduce(&T->b);
+    fp2_reduce(&T->c);
+    fp2_reduce(&T->d);
+}
+
 static inline void apply_ideal_to_theta_chain(thetanullpoint_t *T, oriint_t *challenge) {
     if (theta_is_infinity(T)) return;
     apply_quaternion_to_theta_chain(T, challenge);
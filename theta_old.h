@@ -50,6 +50,28 @@ static inline void canonicalize_theta(ThetaNullPoint_Fp2 *T)
     T->d = fp2_mul(T->d, inva);
 }
 
+/*
+ * Same result as canonicalize_theta, for public points only
+ * (verification path).
+ */
+static inline void canonicalize_theta_vartime(ThetaNullPoint_Fp2 *T)
+{
+    if (fp2_is_zero(T->a)) {
+        T->a = (fp2old_t){0, 0};
+        T->b = (fp2old_t){0, 0};
+        T->c = (fp2old_t){0, 0};
+        T->d = (fp2old_t){0, 0};
+        return;
+    }
+
+    fp2old_t inva = fp2_inv_vartime(T->a);
+
+    T->a = (fp2old_t){1, 0};
+    T->b = fp2_mul(T->b, inva);
+    T->c = fp2_mul(T->c, inva);
+    T->d = fp2_mul(T->d, inva);
+}
+
 /* ============================================================
  * COMPRESSION / DECOMPRESSION
  * ============================================================ */
@@ -76,6 +98,28 @@ theta_decompress(ThetaCompressed_Fp2 C)
     return T;
 }
 
+static inline ThetaCompressed_Fp2
+theta_compress_vartime(ThetaNullPoint_Fp2 T)
+{
+    canonicalize_theta_vartime(&T);
+    return (ThetaCompressed_Fp2){ T.b, T.c, T.d };
+}
+
+static inline ThetaNullPoint_Fp2
+theta_decompress_vartime(ThetaCompressed_Fp2 C)
+{
+    ThetaNullPoint_Fp2 T;
+
+    T.a = (fp2old_t){1, 0};
+    T.b = C.b;
+    T.c = C.c;
+    T.d = C.d;
+
+    canonicalize_theta_vartime(&T);
+
+    return T;
+}
+
 /* ============================================================
  * INFINITY CHECK
  * ============================================================ */
@@ -121,13 +165,49 @@ eval_sq_isogeny_velu_theta(ThetaNullPoint_Fp2 *T,
     T->d = fp2_sub(amb2, xcmd2);
 }
 
+/*
+ * Same step on a projective T = l * (1, b, c, d): apb2 and amb2 are
+ * scaled by a = l to match xT * cpd2 with xT taken from T, so the
+ * result is l^3 times the step on (1, b, c, d).
+ */
+static inline void
+eval_sq_isogeny_velu_theta_proj(ThetaNullPoint_Fp2 *T,
+                                fp2old_t xT)
+{
+    fp2old_t a = T->a;
+    fp2old_t b = T->b;
+    fp2old_t c = T->c;
+    fp2old_t d = T->d;
+
+    fp2old_t apb = fp2_add(a, b);
+    fp2old_t amb = fp2_sub(a, b);
+    fp2old_t cpd = fp2_add(c, d);
+    fp2old_t cmd = fp2_sub(c, d);
+
+    fp2old_t apb2 = fp2_mul(a, fp2_mul(apb, apb));
+    fp2old_t amb2 = fp2_mul(a, fp2_mul(amb, amb));
+    fp2old_t cpd2 = fp2_mul(cpd, cpd);
+    fp2old_t cmd2 = fp2_mul(cmd, cmd);
+
+    fp2old_t xcpd2 = fp2_mul(xT, cpd2);
+    fp2old_t xcmd2 = fp2_mul(xT, cmd2);
+
+    T->a = fp2_add(apb2, xcpd2);
+    T->b = fp2_sub(apb2, xcpd2);
+    T->c = fp2_add(amb2, xcmd2);
+    T->d = fp2_sub(amb2, xcmd2);
+}
+
 /* ============================================================
  * CONSTANT-TIME ISOGENY CHAIN
  * ============================================================ */
 
+/*
+ * Reference chain: canonicalize_theta after every step.
+ */
 static inline void
-apply_quaternion_to_theta_chain(ThetaNullPoint_Fp2 *T,
-                                uint64_t chal)
+apply_quaternion_to_theta_chain_canonical(ThetaNullPoint_Fp2 *T,
+                                          uint64_t chal)
 {
     for (int i = 0; i < SQ_POWER_OLD; i++)
     {
@@ -151,6 +231,38 @@ apply_quaternion_to_theta_chain(ThetaNullPoint_Fp2 *T,
     }
 }
 
+/*
+ * Projective chain, same result as the reference: the first step runs
+ * on T as given, later steps on the unnormalized point, and one
+ * canonicalize_theta at the end. A zero a sends the reference chain to
+ * the zero point for good; that is kept in a mask.
+ */
+static inline void
+apply_quaternion_to_theta_chain(ThetaNullPoint_Fp2 *T,
+                                uint64_t chal)
+{
+    uint64_t zero = 0;
+
+    for (int i = 0; i < SQ_POWER_OLD; i++)
+    {
+        uint64_t bit = (chal >> i) & 1ULL;
+        uint64_t mask = (uint64_t)-(int64_t)bit;
+        fp2old_t xK = fp2_cmov(T->b, T->c, mask);
+
+        if (i == 0)
+            eval_sq_isogeny_velu_theta(T, xK);
+        else
+            eval_sq_isogeny_velu_theta_proj(T, xK);
+        zero |= -(uint64_t)fp2_is_zero(T->a);
+    }
+
+    canonicalize_theta(T);
+    T->a = fp2_cmov((fp2old_t){0, 0}, T->a, zero);
+    T->b = fp2_cmov((fp2old_t){0, 0}, T->b, zero);
+    T->c = fp2_cmov((fp2old_t){0, 0}, T->c, zero);
+    T->d = fp2_cmov((fp2old_t){0, 0}, T->d, zero);
+}
+
 /* ============================================================
  * IDEAL APPLICATION
  * ============================================================ */
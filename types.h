@@ -15,15 +15,35 @@ typedef union {
     int8_t bits8[NBLOCK*2*2*2];
 } oriint_t;
 
+typedef struct { int64_t u, v, q, r; } oriint_trans_t;
+
 typedef struct { oriint_t re, im; } fp2_t;
 typedef struct { oriint_t w, x, y, z; } quaternion_t;
-typedef struct { quaternion_t b[4]; oriint_t norm; } quaternion_ideal_t;
 typedef struct { fp2_t a, b, c, d; } thetanullpoint_t;
 
+// THETA_BATCH_LANES independent theta points, one array per coordinate so
+// the batch chain walks each stage across the lanes in order
+typedef struct {
+    fp2_t a[THETA_BATCH_LANES];
+    fp2_t b[THETA_BATCH_LANES];
+    fp2_t c[THETA_BATCH_LANES];
+    fp2_t d[THETA_BATCH_LANES];
+} __attribute__((aligned(64))) theta_batch_t;
+
+// Storage for reduced elements: 4 limbs (32 bytes) against 5 for oriint_t,
+// which stays the arithmetic type. Values are loaded into oriint_t scratch
+// to compute and stored back reduced (fp_load/fp_store in fp.h).
+typedef struct { uint64_t bitsu64[NBLOCK_PACKED]; } fp_packed_t;
+typedef struct { fp_packed_t re, im; } fp2_packed_t;
+typedef struct { fp_packed_t w, x, y, z; } quaternion_packed_t;
+typedef struct { fp2_packed_t a, b, c, d; } thetapacked_t;
+
+typedef struct { quaternion_packed_t b[4]; fp_packed_t norm; } quaternion_ideal_t;
+
 typedef struct { 
-    fp2_t b;
-    fp2_t c;
-    fp2_t d; 
+    fp2_packed_t b;
+    fp2_packed_t c;
+    fp2_packed_t d; 
 } thetacompressed_t;
 
 typedef struct {